@@ -0,0 +1,1190 @@
+// ============================================================================
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  File   : bench_active_target.cc
+//  Purpose: Benchmark driver with canned workloads (every detector type, proton
+//           and muon primaries, 1 and N threads, fixed seeds). Reports events/s,
+//           steps/s, initialization time, peak RSS and thread scaling efficiency
+//           as JSON and compares them against a stored baseline. Workloads
+//           can batch K primaries per event to measure throughput versus K, and
+//           sub-event parallel twins compare event latency and throughput with
+//           event-level MT, and pinned twins compare thread placement policies
+//           per thread count. Feature twins switch one optimization on
+//           (e.g. --abort, --bias, --stacking, --trajectories, --profile) and
+//           compare its figure against the plain workload (or a reference twin).
+//           A reproducibility mode checks that per-event seeding gives the
+//           same histograms for any thread count.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "G4AnalysisManager.hh"
+#include "G4RunManager.hh"
+#include "G4RunManagerFactory.hh"
+#include "G4Threading.hh"
+#include "G4UIsession.hh"
+#include "G4UImanager.hh"
+#include "QGSP_BERT.hh"
+#include "Randomize.hh"
+
+#include "ActionInitialization.hh"
+#include "DetectorConstruction.hh"
+#include "EventLatency.hh"
+#include "RunAction.hh"
+#include "SubEventParallelism.hh"
+#include "ThreadAffinity.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+// ============================================================================
+// Workloads and Results
+// ============================================================================
+
+/// One canned benchmark configuration.
+struct Workload
+{
+	std::string name;
+	std::string detector;
+	std::string primary; ///< "proton" or "muon"
+	int threads = 1;
+	int primariesPerEvent = 1; ///< K of /ats/gun/primariesPerEvent
+	int subEventTracks = 0;	   ///< tracks per sub-event, 0 for event-level parallelism
+	std::string placement = "none"; ///< /ats/affinity/policy of the workers
+	std::string variant;			///< feature twin (a key of Variants()), empty for the plain workload
+};
+
+/// Measured figures of one workload.
+struct Result
+{
+	Workload workload;
+	int events = 0;
+	long steps = 0;
+	long primaries = 0;			  ///< events x K (protons or muons on target)
+	double initTime = 0.;		  ///< [s] run manager creation to a zero-event BeamOn
+	double runTime = 0.;		  ///< [s] wall time of BeamOn(events)
+	double cpuTime = 0.;		  ///< [s] user plus system CPU time of BeamOn(events), all threads
+	double eventsPerSec = 0.;
+	double stepsPerSec = 0.;
+	double primariesPerSec = 0.;
+	double muons = 0.;			  ///< weighted muons created (entries of MuonEnergy)
+	double muonsPerSec = 0.;
+	double dtStops = 0.;		  ///< weighted muon stops in the D-T gas
+	double dtStopsPerCpuSec = 0.;
+	double fom = 0.;			  ///< D-T stop figure of merit 1 / (R^2 T), T the wall time of the run
+	double peakRssMB = 0.;
+	double scalingEfficiency = -1.; ///< (rate_N / rate_1) / N, -1 for single-threaded workloads
+	double batchingGain = -1.;		///< primaries/s relative to the K = 1 twin, -1 for K = 1
+	double latencyMean = 0.;		///< [s] mean in-run latency of an event alone in its run
+	double latencyMax = 0.;			///< [s] longest such event latency
+	double latencyGain = -1.;		///< event-level latency / sub-event latency, -1 for event-level workloads
+	double placementGain = -1.;		///< events/s relative to the unpinned twin, -1 for unpinned workloads
+	double variantGain = -1.;		///< variant figure relative to the plain twin, -1 for plain workloads
+	std::string histogramDigest;	///< hash of all histogram bin contents after the run
+	bool ok = false;
+};
+
+/// Optimization switched on in a feature twin of a plain workload.
+struct Variant
+{
+	std::vector<std::string> commands; ///< UI commands applied after Initialize
+	double Result::*figure;			   ///< figure the optimization is meant to raise
+	const char *label;				   ///< name of that figure in the summary
+	std::string reference;			   ///< variant the gain is relative to, empty for the plain workload
+};
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the feature twins by name suffix.
+ *
+ * abort: /ats/abort/noPrecursor, judged by muons/s (events without a muon
+ * precursor end early, the muon yield should not drop).
+ * bias: /ats/bias/enable, judged by the D-T stop figure of merit (the
+ * weighted tally stays unbiased, its variance per second should drop).
+ * priority: /ats/stack/priority, muon ancestors first, judged by events/s.
+ * drop: priority stacking plus /ats/stack/dropDeferred, judged by muons/s.
+ * traj: /tracking/storeTrajectory 1 for every track, judged by events/s
+ * against the plain workload (the cost of trajectories).
+ * trajsel: trajectories with /ats/traj/select, judged by events/s against
+ * "traj"; both report the peak RSS that the selection should lower.
+ * profile: /ats/profile/enable, judged by events/s; a gain below 1 is the
+ * overhead of the step profiler.
+ */
+const std::map<std::string, Variant> &Variants()
+{
+	static const std::map<std::string, Variant> variants = {
+		{"abort", {{"/ats/abort/noPrecursor true"}, &Result::muonsPerSec, "muons/s"}},
+		{"bias", {{"/ats/bias/enable true"}, &Result::fom, "FOM"}},
+		{"priority", {{"/ats/stack/priority true"}, &Result::eventsPerSec, "events/s"}},
+		{"drop", {{"/ats/stack/priority true", "/ats/stack/dropDeferred true"}, &Result::muonsPerSec, "muons/s"}},
+		{"traj", {{"/tracking/storeTrajectory 1"}, &Result::eventsPerSec, "events/s"}},
+		{"trajsel",
+		 {{"/tracking/storeTrajectory 1", "/ats/traj/select true"}, &Result::eventsPerSec, "events/s", "traj"}},
+		{"profile", {{"/ats/profile/enable true"}, &Result::eventsPerSec, "events/s"}}};
+	return variants;
+}
+
+/// Command-line options.
+struct Options
+{
+	int events = 100;
+	int threads = 0; ///< 0: number of cores (largest of threadCounts)
+	std::vector<int> threadCounts;				///< N-thread workloads (empty: number of cores)
+	std::vector<std::string> placements = {"none"}; ///< placement policies of the N-thread workloads
+	std::vector<std::string> variants;				///< feature twins of the unpinned event-level workloads
+	long seed = 20250402;
+	double threshold = 0.10;
+	std::string output = "bench_results.json";
+	std::string baseline;
+	std::string filter;
+	std::string workload; ///< internal: run this workload in-process
+	std::string result;	  ///< internal: where the in-process run writes its result
+	std::string reproducibility;				///< workload (without _tN) checked for thread independence
+	std::vector<int> reproThreads = {1, 4, 16}; ///< thread counts of the reproducibility check
+	std::vector<int> primaries = {1};			///< primaries per event (K) of the workloads
+	int subEventTracks = 0;						///< > 0: add sub-event parallel twins of the N-thread workloads
+	int latencyEvents = 0;						///< single-event runs measuring the in-run event latency
+	bool perEventSeeding = false;				///< /ats/seed/perEvent in every workload
+	bool verbose = false;
+};
+
+/// G4cout sink used to keep the simulation log out of the measurements.
+class SilentSession : public G4UIsession
+{
+  public:
+	G4int ReceiveG4cout(const G4String &) override { return 0; }
+	G4int ReceiveG4cerr(const G4String &message) override
+	{
+		std::cerr << message << std::flush;
+		return 0;
+	}
+};
+
+using Clock = std::chrono::steady_clock;
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Builds the workload list: 4 detectors x {proton, muon} x K values x {1, N threads}.
+ *
+ * Workloads with K > 1 primaries per event get a "_k<K>" name suffix, so
+ * the K = 1 names (and baselines) are unchanged. With subEventTracks > 0 every
+ * N-thread workload gets a sub-event parallel twin with an "_se" suffix, and
+ * every placement policy other than "none" a pinned twin with a "_<policy>" suffix.
+ * Every variant adds a feature twin of each unpinned event-level workload with
+ * a "_<variant>" suffix before the thread count.
+ */
+std::vector<Workload> MakeWorkloads(const std::vector<int> &nThreads, const std::vector<int> &primariesPerEvent,
+									int subEventTracks, const std::vector<std::string> &placements,
+									const std::vector<std::string> &variants)
+{
+	const std::vector<std::string> detectors = {"carbonStack", "alternatingLayers", "muonTarget", "openMuonTarget"};
+	const std::vector<std::string> primaries = {"proton", "muon"};
+
+	std::vector<int> threadCounts = {1};
+#ifdef G4MULTITHREADED
+	for (int n : nThreads)
+		if (n > 1 && std::find(threadCounts.begin(), threadCounts.end(), n) == threadCounts.end())
+			threadCounts.push_back(n);
+#endif
+
+	std::vector<Workload> workloads;
+	for (const auto &detector : detectors)
+		for (const auto &primary : primaries)
+			for (int k : primariesPerEvent)
+				for (int threads : threadCounts)
+				{
+					std::string name = detector + "_" + primary + (k > 1 ? "_k" + std::to_string(k) : "");
+					for (const auto &placement : placements)
+					{
+						if (placement == "none" || threads > 1)
+						{
+							std::string suffix = placement == "none" ? "" : "_" + placement;
+							workloads.push_back({name + "_t" + std::to_string(threads) + suffix, detector, primary,
+												 threads, k, 0, placement});
+						}
+					}
+
+					if (threads > 1 && subEventTracks > 0 && SubEventParallelism::IsAvailable())
+						workloads.push_back({name + "_se_t" + std::to_string(threads), detector, primary, threads, k,
+											 subEventTracks});
+
+					for (const auto &variant : variants)
+						if (Variants().count(variant))
+							workloads.push_back({name + "_" + variant + "_t" + std::to_string(threads), detector,
+												 primary, threads, k, 0, "none", variant});
+				}
+
+	return workloads;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the user plus system CPU time of this process (all threads) in seconds.
+ */
+double CpuSeconds()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + 1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the peak resident set size of this process in MB.
+ */
+double PeakRssMB()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return usage.ru_maxrss / (1024. * 1024.); // bytes
+#else
+	return usage.ru_maxrss / 1024.; // kilobytes
+#endif
+}
+
+// ============================================================================
+// JSON Helpers (one workload object per line, flat keys)
+// ============================================================================
+
+/**
+ * @brief Serializes a result as a single-line JSON object.
+ */
+std::string ToJson(const Result &r)
+{
+	std::ostringstream out;
+	out << std::setprecision(6)
+		<< "{\"name\": \"" << r.workload.name << "\""
+		<< ", \"detector\": \"" << r.workload.detector << "\""
+		<< ", \"primary\": \"" << r.workload.primary << "\""
+		<< ", \"threads\": " << r.workload.threads
+		<< ", \"primaries_per_event\": " << r.workload.primariesPerEvent
+		<< ", \"sub_event_tracks\": " << r.workload.subEventTracks
+		<< ", \"placement\": \"" << r.workload.placement << "\""
+		<< ", \"variant\": \"" << r.workload.variant << "\""
+		<< ", \"events\": " << r.events
+		<< ", \"primaries\": " << r.primaries
+		<< ", \"steps\": " << r.steps
+		<< ", \"init_time_s\": " << r.initTime
+		<< ", \"run_time_s\": " << r.runTime
+		<< ", \"cpu_time_s\": " << r.cpuTime
+		<< ", \"events_per_sec\": " << r.eventsPerSec
+		<< ", \"steps_per_sec\": " << r.stepsPerSec
+		<< ", \"primaries_per_sec\": " << r.primariesPerSec
+		<< ", \"muons\": " << r.muons
+		<< ", \"muons_per_sec\": " << r.muonsPerSec
+		<< ", \"dt_stops\": " << r.dtStops
+		<< ", \"dt_stops_per_cpu_sec\": " << r.dtStopsPerCpuSec
+		<< ", \"fom\": " << r.fom
+		<< ", \"peak_rss_mb\": " << r.peakRssMB
+		<< ", \"scaling_efficiency\": " << r.scalingEfficiency
+		<< ", \"batching_gain\": " << r.batchingGain
+		<< ", \"event_latency_s\": " << r.latencyMean
+		<< ", \"event_latency_max_s\": " << r.latencyMax
+		<< ", \"latency_gain\": " << r.latencyGain
+		<< ", \"placement_gain\": " << r.placementGain
+		<< ", \"variant_gain\": " << r.variantGain
+		<< ", \"histogram_digest\": \"" << r.histogramDigest << "\""
+		<< ", \"ok\": " << (r.ok ? "true" : "false") << "}";
+	return out.str();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the raw value following "key": in a flat JSON line, or "" if absent.
+ */
+std::string ExtractValue(const std::string &line, const std::string &key)
+{
+	std::string pattern = "\"" + key + "\":";
+	size_t pos = line.find(pattern);
+	if (pos == std::string::npos)
+		return "";
+
+	pos = line.find_first_not_of(' ', pos + pattern.size());
+	if (pos == std::string::npos)
+		return "";
+
+	if (line[pos] == '"')
+	{
+		size_t end = line.find('"', pos + 1);
+		return line.substr(pos + 1, end - pos - 1);
+	}
+
+	size_t end = line.find_first_of(",}", pos);
+	return line.substr(pos, end - pos);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Parses a line written by ToJson(); returns false if it holds no workload.
+ */
+bool FromJson(const std::string &line, Result &r)
+{
+	r.workload.name = ExtractValue(line, "name");
+	if (r.workload.name.empty())
+		return false;
+
+	auto number = [&line](const std::string &key) {
+		std::string value = ExtractValue(line, key);
+		return value.empty() ? 0. : std::atof(value.c_str());
+	};
+
+	r.workload.detector = ExtractValue(line, "detector");
+	r.workload.primary = ExtractValue(line, "primary");
+	r.workload.threads = static_cast<int>(number("threads"));
+	r.workload.primariesPerEvent = std::max(1, static_cast<int>(number("primaries_per_event")));
+	r.workload.subEventTracks = static_cast<int>(number("sub_event_tracks"));
+	r.workload.placement = ExtractValue(line, "placement");
+	if (r.workload.placement.empty())
+		r.workload.placement = "none";
+	r.workload.variant = ExtractValue(line, "variant");
+	r.events = static_cast<int>(number("events"));
+	r.primaries = static_cast<long>(number("primaries"));
+	r.steps = static_cast<long>(number("steps"));
+	r.initTime = number("init_time_s");
+	r.runTime = number("run_time_s");
+	r.cpuTime = number("cpu_time_s");
+	r.eventsPerSec = number("events_per_sec");
+	r.stepsPerSec = number("steps_per_sec");
+	r.primariesPerSec = number("primaries_per_sec");
+	r.muons = number("muons");
+	r.muonsPerSec = number("muons_per_sec");
+	r.dtStops = number("dt_stops");
+	r.dtStopsPerCpuSec = number("dt_stops_per_cpu_sec");
+	r.fom = number("fom");
+	r.peakRssMB = number("peak_rss_mb");
+	r.scalingEfficiency = number("scaling_efficiency");
+	r.batchingGain = ExtractValue(line, "batching_gain").empty() ? -1. : number("batching_gain");
+	r.latencyMean = number("event_latency_s");
+	r.latencyMax = number("event_latency_max_s");
+	r.latencyGain = ExtractValue(line, "latency_gain").empty() ? -1. : number("latency_gain");
+	r.placementGain = ExtractValue(line, "placement_gain").empty() ? -1. : number("placement_gain");
+	r.variantGain = ExtractValue(line, "variant_gain").empty() ? -1. : number("variant_gain");
+	r.histogramDigest = ExtractValue(line, "histogram_digest");
+	r.ok = ExtractValue(line, "ok") == "true";
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Reads every workload line of a results file.
+ */
+std::vector<Result> ReadResults(const std::string &fileName)
+{
+	std::vector<Result> results;
+	std::ifstream in(fileName);
+	std::string line;
+	while (std::getline(in, line))
+	{
+		Result r;
+		if (FromJson(line, r))
+			results.push_back(r);
+	}
+	return results;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Writes the full report (configuration plus one line per workload).
+ */
+void WriteReport(const std::string &fileName, const Options &opt, int nThreads, const std::vector<Result> &results)
+{
+	std::ofstream out(fileName);
+	out << "{\n"
+		<< "  \"benchmark\": \"bench_active_target\",\n"
+		<< "  \"events\": " << opt.events << ",\n"
+		<< "  \"threads\": " << nThreads << ",\n"
+		<< "  \"seed\": " << opt.seed << ",\n"
+		<< "  \"workloads\": [\n";
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		out << "    " << ToJson(results[i]) << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "  ]\n}\n";
+}
+
+// ============================================================================
+// In-Process Workload
+// ============================================================================
+
+/**
+ * @brief FNV-1a hash of the entries and per-bin sums of weights (and squares) of every H1.
+ *
+ * Covers exactly what per-event seeding makes independent of the thread
+ * count; moment sums (sum of x*w) depend on the merge order and are left out.
+ */
+std::string HistogramDigest()
+{
+	std::uint64_t hash = 1469598103934665603ULL;
+	auto add = [&hash](double value) {
+		unsigned char bytes[sizeof(double)];
+		std::memcpy(bytes, &value, sizeof(double));
+		for (unsigned char byte : bytes)
+		{
+			hash ^= byte;
+			hash *= 1099511628211ULL;
+		}
+	};
+
+	auto analysisManager = G4AnalysisManager::Instance();
+	G4int firstID = analysisManager->GetFirstH1Id();
+	for (G4int i = 0; i < analysisManager->GetNofH1s(); ++i)
+	{
+		auto h1 = analysisManager->GetH1(firstID + i, false);
+		if (!h1)
+			continue;
+		add(h1->all_entries());
+		for (double w : h1->bins_sum_w())
+			add(w);
+		for (double w2 : h1->bins_sum_w2())
+			add(w2);
+	}
+
+	std::ostringstream out;
+	out << std::hex << std::setw(16) << std::setfill('0') << hash;
+	return out.str();
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Runs one workload in this process and measures it.
+ *
+ * Every workload runs in a fresh process (see SpawnWorkload()), so geometry and
+ * physics are built from scratch and the peak RSS belongs to this workload only.
+ */
+Result RunWorkload(const Workload &w, const Options &opt)
+{
+	Result r;
+	r.workload = w;
+	r.events = opt.events;
+
+	SilentSession silent;
+	if (!opt.verbose)
+		G4UImanager::GetUIpointer()->SetCoutDestination(&silent);
+
+	auto start = Clock::now();
+
+	G4RunManager *runManager = nullptr;
+	if (w.subEventTracks > 0)
+	{
+		runManager = SubEventParallelism::CreateRunManager(w.threads, w.subEventTracks);
+		if (!runManager)
+		{
+			G4UImanager::GetUIpointer()->SetCoutDestination(nullptr);
+			return r;
+		}
+	}
+	else
+	{
+		auto type = w.threads > 1 ? G4RunManagerType::MTOnly : G4RunManagerType::SerialOnly;
+		runManager = G4RunManagerFactory::CreateRunManager(type, w.threads);
+
+		// Worker placement, applied before the workers start (at Initialize)
+		if (w.threads > 1)
+		{
+			runManager->SetUserInitialization(new ThreadAffinity());
+			G4UImanager::GetUIpointer()->ApplyCommand("/ats/affinity/policy " + w.placement);
+		}
+	}
+
+	G4Random::setTheSeed(opt.seed);
+
+	auto *detector = new DetectorConstruction();
+	detector->SetDetectorType(w.detector);
+	runManager->SetUserInitialization(detector);
+	runManager->SetUserInitialization(new QGSP_BERT());
+	runManager->SetUserInitialization(new ActionInitialization(detector));
+	runManager->Initialize();
+
+	// Primary selection (worker commands are known to the master after Initialize)
+	auto *UImanager = G4UImanager::GetUIpointer();
+	UImanager->ApplyCommand("/ats/gun/mode " + w.primary);
+	UImanager->ApplyCommand("/ats/gun/primariesPerEvent " + std::to_string(w.primariesPerEvent));
+	if (opt.perEventSeeding)
+	{
+		UImanager->ApplyCommand("/ats/seed/perEvent true");
+		UImanager->ApplyCommand("/ats/seed/master " + std::to_string(opt.seed));
+	}
+	if (!w.variant.empty())
+		for (const auto &command : Variants().at(w.variant).commands)
+			UImanager->ApplyCommand(command);
+
+	// Zero-event run: builds the physics tables, so they count as initialization
+	runManager->BeamOn(0);
+	r.initTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+	auto runStart = Clock::now();
+	double cpuStart = CpuSeconds();
+	runManager->BeamOn(opt.events);
+	r.runTime = std::chrono::duration<double>(Clock::now() - runStart).count();
+	r.cpuTime = CpuSeconds() - cpuStart;
+
+	auto runAction = static_cast<const RunAction *>(runManager->GetUserRunAction());
+	r.steps = runAction ? runAction->GetNumberOfSteps() : 0;
+	r.primaries = runAction ? runAction->GetNumberOfPrimaries() : 0;
+	r.eventsPerSec = r.runTime > 0. ? opt.events / r.runTime : 0.;
+	r.stepsPerSec = r.runTime > 0. ? r.steps / r.runTime : 0.;
+	r.primariesPerSec = r.runTime > 0. ? r.primaries / r.runTime : 0.;
+	auto muonEnergy = G4AnalysisManager::Instance()->GetH1(0, false); // Histogram 0: MuonEnergy (weighted)
+	r.muons = muonEnergy ? muonEnergy->sum_all_bin_heights() : 0.;
+	r.muonsPerSec = r.runTime > 0. ? r.muons / r.runTime : 0.;
+
+	// D-T stops per event as in RunAction::PrintFigureOfMerit(): FOM = 1 / (R^2 T)
+	r.dtStops = runAction ? runAction->GetDTStopSum() : 0.;
+	r.dtStopsPerCpuSec = r.cpuTime > 0. ? r.dtStops / r.cpuTime : 0.;
+	if (opt.events > 1 && r.dtStops > 0. && r.runTime > 0.)
+	{
+		double n = opt.events;
+		double mean = r.dtStops / n;
+		double variance = std::max(0., runAction->GetDTStopSum2() / n - mean * mean) * n / (n - 1.);
+		double relError2 = variance / n / (mean * mean);
+		r.fom = relError2 > 0. ? 1. / (relError2 * r.runTime) : 0.;
+	}
+	r.peakRssMB = PeakRssMB();
+	r.histogramDigest = HistogramDigest();
+
+	// Event latency: one event in flight per run, timed inside the run from its
+	// BeginOfEventAction to the end of its last sub-event (no run start-up or output)
+	if (opt.latencyEvents > 0)
+	{
+		EventLatency::SetEnabled(true);
+		double sum = 0.;
+		int measured = 0;
+		for (int i = 0; i < opt.latencyEvents; ++i)
+		{
+			EventLatency::Reset();
+			runManager->BeamOn(1);
+			if (EventLatency::GetNumberOfEvents() == 0)
+				continue;
+
+			double seconds = EventLatency::GetMaxSeconds();
+			sum += seconds;
+			++measured;
+			r.latencyMax = std::max(r.latencyMax, seconds);
+		}
+		r.latencyMean = measured > 0 ? sum / measured : 0.;
+		EventLatency::SetEnabled(false);
+	}
+
+	r.ok = true;
+
+	delete runManager;
+	G4UImanager::GetUIpointer()->SetCoutDestination(nullptr);
+
+	return r;
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+/**
+ * @brief Re-executes this binary for one workload and collects its result.
+ */
+Result SpawnWorkload(const char *self, const Workload &w, const Options &opt)
+{
+	Result r;
+	r.workload = w;
+	r.events = opt.events;
+
+	std::string resultFile = "bench_" + w.name + "_" + std::to_string(getpid()) + ".tmp.json";
+	std::vector<std::string> args = {self,
+									 "--workload", w.name,
+									 "--events", std::to_string(opt.events),
+									 "--threads", std::to_string(w.threads),
+									 "--seed", std::to_string(opt.seed),
+									 "--primaries", std::to_string(w.primariesPerEvent),
+									 "--subevent", std::to_string(opt.subEventTracks),
+									 "--affinity", w.placement,
+									 "--latency-events", std::to_string(opt.latencyEvents),
+									 "--result", resultFile};
+	if (!w.variant.empty())
+	{
+		args.push_back("--variant");
+		args.push_back(w.variant);
+	}
+	if (opt.perEventSeeding)
+		args.push_back("--per-event-seeding");
+	if (opt.verbose)
+		args.push_back("--verbose");
+
+	std::vector<char *> argv;
+	for (auto &arg : args)
+		argv.push_back(const_cast<char *>(arg.c_str()));
+	argv.push_back(nullptr);
+
+	std::cout << "[Bench] Running " << w.name << " ..." << std::flush;
+
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		execvp(self, argv.data());
+		_exit(127);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	std::vector<Result> child = ReadResults(resultFile);
+	std::remove(resultFile.c_str());
+
+	if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && !child.empty())
+	{
+		r = child.front();
+		std::cout << " " << r.eventsPerSec << " events/s";
+		if (r.workload.primariesPerEvent > 1)
+			std::cout << ", " << r.primariesPerSec << " primaries/s";
+		if (!r.workload.variant.empty())
+			std::cout << ", " << r.muonsPerSec << " muons/s, " << r.dtStopsPerCpuSec << " D-T stops/CPU-s, FOM "
+					  << r.fom << ", peak RSS " << r.peakRssMB << " MB";
+		std::cout << std::endl;
+	}
+	else
+	{
+		std::cout << " FAILED" << std::endl;
+	}
+
+	return r;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Fills the scaling efficiency of every N-thread workload from its 1-thread twin.
+ */
+void ComputeScaling(std::vector<Result> &results)
+{
+	for (auto &r : results)
+	{
+		if (r.workload.threads <= 1 || !r.ok)
+			continue;
+
+		for (const auto &single : results)
+		{
+			if (single.workload.threads == 1 && single.ok && single.eventsPerSec > 0. &&
+				single.workload.detector == r.workload.detector && single.workload.primary == r.workload.primary &&
+				single.workload.primariesPerEvent == r.workload.primariesPerEvent &&
+				single.workload.variant == r.workload.variant)
+			{
+				r.scalingEfficiency = r.eventsPerSec / single.eventsPerSec / r.workload.threads;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Fills the batching gain of every K > 1 workload from its K = 1 twin.
+ *
+ * The gain compares primaries/s, i.e. protons (or muons) on target per second,
+ * so it measures what batching saves in per-event overhead.
+ */
+void ComputeBatchingGain(std::vector<Result> &results)
+{
+	for (auto &r : results)
+	{
+		if (r.workload.primariesPerEvent <= 1 || !r.ok)
+			continue;
+
+		for (const auto &single : results)
+		{
+			if (single.workload.primariesPerEvent == 1 && single.ok && single.primariesPerSec > 0. &&
+				single.workload.detector == r.workload.detector && single.workload.primary == r.workload.primary &&
+				single.workload.threads == r.workload.threads &&
+				single.workload.subEventTracks == r.workload.subEventTracks &&
+				single.workload.placement == r.workload.placement && single.workload.variant == r.workload.variant)
+			{
+				r.batchingGain = r.primariesPerSec / single.primariesPerSec;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Fills the latency gain of every sub-event workload from its event-level twin.
+ *
+ * The twin runs the same detector, primary, K and thread count with
+ * event-level parallelism; a gain above 1 means heavy events finish sooner.
+ */
+void ComputeLatencyGain(std::vector<Result> &results)
+{
+	for (auto &r : results)
+	{
+		if (r.workload.subEventTracks <= 0 || !r.ok || r.latencyMean <= 0.)
+			continue;
+
+		for (const auto &twin : results)
+		{
+			if (twin.workload.subEventTracks == 0 && twin.ok && twin.latencyMean > 0. &&
+				twin.workload.detector == r.workload.detector && twin.workload.primary == r.workload.primary &&
+				twin.workload.primariesPerEvent == r.workload.primariesPerEvent &&
+				twin.workload.threads == r.workload.threads && twin.workload.placement == r.workload.placement &&
+				twin.workload.variant.empty())
+			{
+				r.latencyGain = twin.latencyMean / r.latencyMean;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Fills the placement gain of every pinned workload from its unpinned twin.
+ */
+void ComputePlacementGain(std::vector<Result> &results)
+{
+	for (auto &r : results)
+	{
+		if (r.workload.placement == "none" || !r.ok)
+			continue;
+
+		for (const auto &twin : results)
+		{
+			if (twin.workload.placement == "none" && twin.workload.subEventTracks == 0 && twin.ok &&
+				twin.eventsPerSec > 0. && twin.workload.detector == r.workload.detector &&
+				twin.workload.primary == r.workload.primary &&
+				twin.workload.primariesPerEvent == r.workload.primariesPerEvent &&
+				twin.workload.threads == r.workload.threads && twin.workload.variant.empty())
+			{
+				r.placementGain = r.eventsPerSec / twin.eventsPerSec;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Fills the variant gain of every feature twin from its reference twin.
+ *
+ * The gain compares the figure of the variant (see Variants()) with the same
+ * workload run as the variant's reference (the plain workload unless stated),
+ * so above 1 means the optimization pays off for that workload.
+ */
+void ComputeVariantGain(std::vector<Result> &results)
+{
+	for (auto &r : results)
+	{
+		if (r.workload.variant.empty() || !r.ok)
+			continue;
+
+		const Variant &variant = Variants().at(r.workload.variant);
+		double Result::*figure = variant.figure;
+		for (const auto &twin : results)
+		{
+			if (twin.workload.variant == variant.reference && twin.workload.placement == "none" &&
+				twin.workload.subEventTracks == 0 && twin.ok && twin.*figure > 0. &&
+				twin.workload.detector == r.workload.detector && twin.workload.primary == r.workload.primary &&
+				twin.workload.primariesPerEvent == r.workload.primariesPerEvent &&
+				twin.workload.threads == r.workload.threads)
+			{
+				r.variantGain = r.*figure / twin.*figure;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the mean throughput of every (thread count, placement) pair over all workloads.
+ */
+void PrintPlacementSummary(const std::vector<Result> &results)
+{
+	struct Sum
+	{
+		double eventsPerSec = 0.;
+		double gain = 0.;
+		int n = 0;
+		int nGain = 0;
+	};
+	std::map<std::pair<int, std::string>, Sum> sums;
+	for (const auto &r : results)
+	{
+		if (!r.ok || r.workload.threads <= 1 || r.workload.subEventTracks > 0 || !r.workload.variant.empty())
+			continue;
+
+		Sum &sum = sums[{r.workload.threads, r.workload.placement}];
+		sum.eventsPerSec += r.eventsPerSec;
+		++sum.n;
+		if (r.placementGain >= 0.)
+		{
+			sum.gain += r.placementGain;
+			++sum.nGain;
+		}
+	}
+
+	if (sums.size() <= 1)
+		return;
+
+	std::cout << "=== Placement Summary ===" << std::endl;
+	for (const auto &entry : sums)
+	{
+		const Sum &sum = entry.second;
+		std::cout << "threads: " << entry.first.first << " | placement: " << entry.first.second
+				  << " | workloads: " << sum.n << " | mean events/s: " << sum.eventsPerSec / sum.n;
+		if (sum.nGain > 0)
+			std::cout << " | mean gain vs unpinned: " << sum.gain / sum.nGain;
+		std::cout << std::endl;
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Compares the results against a baseline file.
+ *
+ * Throughput (events/s, steps/s, primaries/s, muons/s) regresses when it drops by more than the
+ * threshold; initialization time, event latency and peak RSS regress when they
+ * grow by more than the threshold. Workloads missing from either side are reported, not failed.
+ *
+ * @return Number of regressions.
+ */
+int CompareToBaseline(const std::vector<Result> &results, const std::string &baselineFile, double threshold)
+{
+	std::map<std::string, Result> baseline;
+	for (const auto &b : ReadResults(baselineFile))
+		baseline[b.workload.name] = b;
+
+	if (baseline.empty())
+	{
+		std::cerr << "[Bench] Baseline " << baselineFile << " has no workloads" << std::endl;
+		return 0;
+	}
+
+	struct Metric
+	{
+		const char *label;
+		double Result::*value;
+		bool higherIsBetter;
+	};
+	const Metric metrics[] = {{"events/s", &Result::eventsPerSec, true},
+							  {"steps/s", &Result::stepsPerSec, true},
+							  {"primaries/s", &Result::primariesPerSec, true},
+							  {"muons/s", &Result::muonsPerSec, true},
+							  {"init [s]", &Result::initTime, false},
+							  {"latency [s]", &Result::latencyMean, false},
+							  {"peak RSS [MB]", &Result::peakRssMB, false}};
+
+	int nRegressions = 0;
+	std::cout << "=== Baseline Comparison (threshold " << threshold * 100. << "%) ===" << std::endl;
+	for (const auto &r : results)
+	{
+		auto it = baseline.find(r.workload.name);
+		if (it == baseline.end() || !r.ok || !it->second.ok)
+		{
+			std::cout << r.workload.name << " | no baseline" << std::endl;
+			continue;
+		}
+
+		for (const auto &m : metrics)
+		{
+			double before = it->second.*(m.value);
+			double after = r.*(m.value);
+			if (before <= 0.)
+				continue;
+
+			double change = (after - before) / before;
+			bool regressed = m.higherIsBetter ? change < -threshold : change > threshold;
+			if (regressed)
+				++nRegressions;
+
+			std::cout << r.workload.name << " | " << m.label
+					  << " | baseline: " << before << " | now: " << after
+					  << " | change: " << std::showpos << change * 100. << std::noshowpos << "%"
+					  << (regressed ? " | REGRESSION" : "") << std::endl;
+		}
+	}
+
+	return nRegressions;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Runs one workload on several thread counts with per-event seeding and compares the histograms.
+ *
+ * Regression check for /ats/seed/perEvent: every run must give the same
+ * histogram digest as the first one. At least two thread counts must run,
+ * otherwise nothing was compared (e.g. a sequential Geant4 build).
+ *
+ * @return 0 if all digests agree, 1 on a mismatch, 2 if a run failed or fewer than two ran.
+ */
+int CheckReproducibility(const char *self, Options opt)
+{
+	opt.perEventSeeding = true;
+
+	std::vector<Result> results;
+	for (int threads : opt.reproThreads)
+	{
+		std::string name = opt.reproducibility + "_t" + std::to_string(threads);
+		const auto workloads = MakeWorkloads({threads}, opt.primaries, opt.subEventTracks, {"none"}, {});
+		auto it = std::find_if(workloads.begin(), workloads.end(), [&name](const Workload &w) { return w.name == name; });
+		if (it == workloads.end())
+		{
+			std::cout << "[Bench] No workload " << name << " (multithreaded Geant4 needed for threads > 1)" << std::endl;
+			continue;
+		}
+
+		Options child = opt;
+		child.threads = threads;
+		results.push_back(SpawnWorkload(self, *it, child));
+	}
+
+	int status = 0;
+	std::cout << "=== Reproducibility Check ===" << std::endl;
+	for (const auto &r : results)
+	{
+		bool same = r.ok && r.histogramDigest == results.front().histogramDigest;
+		if (!r.ok)
+			status = 2;
+		else if (!same && status == 0)
+			status = 1;
+
+		std::cout << r.workload.name << " | threads: " << r.workload.threads << " | digest: " << r.histogramDigest
+				  << (r.ok ? (same ? " | OK" : " | MISMATCH") : " | FAILED") << std::endl;
+	}
+
+	if (results.size() < 2)
+	{
+		std::cout << "[Bench] Fewer than two thread counts ran: nothing to compare" << std::endl;
+		return 2;
+	}
+	return status;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the command-line help.
+ */
+void PrintUsage()
+{
+	std::cout << "Usage: bench_active_target [options]\n"
+			  << "  --events N        events per workload (default 100)\n"
+			  << "  --threads L       thread counts of the multithreaded workloads, e.g. 8,16,32 (default: all cores)\n"
+			  << "  --affinity L      placement policies of the multithreaded workloads: none, compact, scatter\n"
+			  << "                    (default none; e.g. none,compact,scatter)\n"
+			  << "  --seed S          master random seed (default 20250402)\n"
+			  << "  --filter TEXT     only run workloads whose name contains TEXT\n"
+			  << "  --output FILE     JSON report (default bench_results.json)\n"
+			  << "  --baseline FILE   compare against a previous report\n"
+			  << "  --threshold X     allowed relative regression (default 0.10)\n"
+			  << "  --per-event-seeding   seed every event from (seed, run, event)\n"
+			  << "  --reproducibility W   run workload W (e.g. openMuonTarget_proton) on several thread\n"
+			  << "                        counts with per-event seeding and compare the histograms\n"
+			  << "  --repro-threads L     thread counts of the reproducibility check (default 1,4,16)\n"
+			  << "  --primaries L     primaries per event K of the workloads, e.g. 1,4,16 (default 1)\n"
+			  << "  --subevent T      add sub-event parallel twins (_se) of the N-thread workloads,\n"
+			  << "                    T tracks per sub-event (Geant4 11.2+, multithreaded builds)\n"
+			  << "  --latency-events M  measure the event latency with M single-event runs (default 0: off)\n"
+			  << "  --abort           add early-abort twins (_abort, /ats/abort/noPrecursor) compared by muons/s\n"
+			  << "  --bias            add importance-splitting twins (_bias, /ats/bias/enable) compared by the\n"
+			  << "                    D-T stop figure of merit\n"
+			  << "  --stacking        add priority-stacking twins: _priority (/ats/stack/priority) compared by\n"
+			  << "                    events/s, _drop (plus /ats/stack/dropDeferred) compared by muons/s\n"
+			  << "  --trajectories    add trajectory twins: _traj (/tracking/storeTrajectory 1) and _trajsel\n"
+			  << "                    (plus /ats/traj/select) compared with _traj by events/s and peak RSS\n"
+			  << "  --profile         add step-profiler twins (_profile, /ats/profile/enable) to measure its overhead\n"
+			  << "  --verbose         keep the simulation output\n";
+}
+} // namespace
+
+// ============================================================================
+// Entry Point
+// ============================================================================
+
+/**
+ * @brief Entry point of the benchmark.
+ *
+ * @return 0 on success, 1 if a metric regressed beyond the threshold, 2 if a workload failed.
+ */
+int main(int argc, char **argv)
+{
+	Options opt;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		auto next = [&]() -> std::string { return i + 1 < argc ? argv[++i] : ""; };
+
+		if (arg == "--events")
+			opt.events = std::atoi(next().c_str());
+		else if (arg == "--threads")
+		{
+			opt.threadCounts.clear();
+			std::istringstream list(next());
+			for (std::string item; std::getline(list, item, ',');)
+				opt.threadCounts.push_back(std::atoi(item.c_str()));
+			opt.threads = opt.threadCounts.empty() ? 0 : *std::max_element(opt.threadCounts.begin(), opt.threadCounts.end());
+		}
+		else if (arg == "--affinity")
+		{
+			opt.placements.clear();
+			std::istringstream list(next());
+			for (std::string item; std::getline(list, item, ',');)
+				opt.placements.push_back(item);
+		}
+		else if (arg == "--seed")
+			opt.seed = std::atol(next().c_str());
+		else if (arg == "--threshold")
+			opt.threshold = std::atof(next().c_str());
+		else if (arg == "--output")
+			opt.output = next();
+		else if (arg == "--baseline")
+			opt.baseline = next();
+		else if (arg == "--filter")
+			opt.filter = next();
+		else if (arg == "--workload")
+			opt.workload = next();
+		else if (arg == "--result")
+			opt.result = next();
+		else if (arg == "--per-event-seeding")
+			opt.perEventSeeding = true;
+		else if (arg == "--reproducibility")
+			opt.reproducibility = next();
+		else if (arg == "--repro-threads")
+		{
+			opt.reproThreads.clear();
+			std::istringstream list(next());
+			for (std::string item; std::getline(list, item, ',');)
+				opt.reproThreads.push_back(std::atoi(item.c_str()));
+		}
+		else if (arg == "--subevent")
+			opt.subEventTracks = std::atoi(next().c_str());
+		else if (arg == "--latency-events")
+			opt.latencyEvents = std::atoi(next().c_str());
+		else if (arg == "--primaries")
+		{
+			opt.primaries.clear();
+			std::istringstream list(next());
+			for (std::string item; std::getline(list, item, ',');)
+				opt.primaries.push_back(std::max(1, std::atoi(item.c_str())));
+		}
+		else if (arg == "--abort")
+			opt.variants.push_back("abort");
+		else if (arg == "--bias")
+			opt.variants.push_back("bias");
+		else if (arg == "--stacking")
+		{
+			opt.variants.push_back("priority");
+			opt.variants.push_back("drop");
+		}
+		else if (arg == "--trajectories")
+		{
+			opt.variants.push_back("traj");
+			opt.variants.push_back("trajsel");
+		}
+		else if (arg == "--profile")
+			opt.variants.push_back("profile");
+		else if (arg == "--variant")
+			opt.variants.push_back(next());
+		else if (arg == "--verbose")
+			opt.verbose = true;
+		else
+		{
+			PrintUsage();
+			return arg == "--help" ? 0 : 2;
+		}
+	}
+
+	int nThreads = opt.threads > 0 ? opt.threads : G4Threading::G4GetNumberOfCores();
+
+	// ----- Child: run a single workload -----
+	if (!opt.workload.empty())
+	{
+		// The driver passes the workload's own thread count, so "_tN" names resolve here
+		for (const auto &w : MakeWorkloads({std::max(nThreads, 2)}, opt.primaries, opt.subEventTracks, opt.placements,
+											 opt.variants))
+		{
+			if (w.name == opt.workload)
+			{
+				Result r = RunWorkload(w, opt);
+				std::ofstream(opt.result) << ToJson(r) << "\n";
+				return r.ok ? 0 : 2;
+			}
+		}
+		std::cerr << "[Bench] Unknown workload " << opt.workload << std::endl;
+		return 2;
+	}
+
+	// ----- Reproducibility: one workload, several thread counts, same histograms -----
+	if (!opt.reproducibility.empty())
+		return CheckReproducibility(argv[0], opt);
+
+	// ----- Driver: run every workload in its own process -----
+	std::vector<Result> results;
+	G4bool failed = false;
+	if (opt.subEventTracks > 0 && !SubEventParallelism::IsAvailable())
+		std::cout << "[Bench] Sub-event parallel mode needs Geant4 11.2+ with multithreading: no _se workloads" << std::endl;
+
+	const std::vector<int> threadCounts = opt.threadCounts.empty() ? std::vector<int>{nThreads} : opt.threadCounts;
+	for (const auto &w : MakeWorkloads(threadCounts, opt.primaries, opt.subEventTracks, opt.placements, opt.variants))
+	{
+		if (!opt.filter.empty() && w.name.find(opt.filter) == std::string::npos)
+			continue;
+
+		results.push_back(SpawnWorkload(argv[0], w, opt));
+		failed = failed || !results.back().ok;
+	}
+
+	ComputeScaling(results);
+	ComputeBatchingGain(results);
+	ComputeLatencyGain(results);
+	ComputePlacementGain(results);
+	ComputeVariantGain(results);
+	WriteReport(opt.output, opt, nThreads, results);
+
+	std::cout << "=== Benchmark Summary ===" << std::endl;
+	for (const auto &r : results)
+	{
+		std::cout << r.workload.name
+				  << " | events/s: " << r.eventsPerSec
+				  << " | steps/s: " << r.stepsPerSec
+				  << " | primaries/s: " << r.primariesPerSec
+				  << " | muons/s: " << r.muonsPerSec
+				  << " | D-T stops/CPU-s: " << r.dtStopsPerCpuSec
+				  << " | FOM: " << r.fom
+				  << " | init: " << r.initTime << " s"
+				  << " | peak RSS: " << r.peakRssMB << " MB";
+		if (r.scalingEfficiency >= 0.)
+			std::cout << " | scaling efficiency: " << r.scalingEfficiency;
+		if (r.batchingGain >= 0.)
+			std::cout << " | batching gain: " << r.batchingGain;
+		if (r.latencyMean > 0.)
+			std::cout << " | latency: " << r.latencyMean << " s (max " << r.latencyMax << " s)";
+		if (r.latencyGain >= 0.)
+			std::cout << " | latency gain: " << r.latencyGain;
+		if (r.placementGain >= 0.)
+			std::cout << " | placement gain: " << r.placementGain;
+		if (r.variantGain >= 0.)
+		{
+			const Variant &variant = Variants().at(r.workload.variant);
+			std::cout << " | " << r.workload.variant << " gain (" << variant.label
+					  << (variant.reference.empty() ? "" : " vs " + variant.reference) << "): " << r.variantGain;
+		}
+		std::cout << std::endl;
+	}
+	PrintPlacementSummary(results);
+	std::cout << "Report written to " << opt.output << std::endl;
+
+	int nRegressions = opt.baseline.empty() ? 0 : CompareToBaseline(results, opt.baseline, opt.threshold);
+
+	if (failed)
+		return 2;
+	return nRegressions > 0 ? 1 : 0;
+}
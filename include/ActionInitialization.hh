@@ -0,0 +1,61 @@
+// ============================================================================
+//  File   : ActionInitialization.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the ActionInitialization class, which instantiates the
+//           user actions for the master and for each worker thread.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef ACTION_INITIALIZATION_HH
+#define ACTION_INITIALIZATION_HH
+
+#include "G4VUserActionInitialization.hh"
+
+class DetectorConstruction;
+
+// ============================================================================
+// ActionInitialization Class Declaration
+// ============================================================================
+/**
+ * @class ActionInitialization
+ * @brief Creates the user actions, once per thread.
+ *
+ * With a sequential run manager Build() is called once. With a multithreaded or
+ * tasking run manager BuildForMaster() creates the master RunAction (which merges
+ * the accumulables and prints the summaries) and Build() is called on each worker,
+ * so every thread owns its own event, stepping, tracking and stacking actions.
+ */
+class ActionInitialization : public G4VUserActionInitialization
+{
+  public:
+	/**
+	 * @brief Constructor.
+	 * @param detectorConstruction Pointer to the geometry, shared read-only by all threads.
+	 */
+	ActionInitialization(const DetectorConstruction *detectorConstruction);
+
+	/**
+	 * @brief Destructor.
+	 */
+	virtual ~ActionInitialization() = default;
+
+	/**
+	 * @brief Creates the run action of the master thread.
+	 */
+	virtual void BuildForMaster() const override;
+
+	/**
+	 * @brief Creates all user actions of a worker (or of the sequential run manager).
+	 */
+	virtual void Build() const override;
+
+  private:
+	/// Pointer to detector construction class, handed to the stepping action.
+	const DetectorConstruction *fDetectorConstruction;
+};
+// ============================================================================
+
+#endif
@@ -0,0 +1,176 @@
+// ============================================================================
+//  File   : CheckpointManager.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the CheckpointManager class, which periodically writes
+//           the merged histograms, run counters and RNG states to a ROOT file
+//           (atomically replaced) and can resume a run from such a file.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef CHECKPOINT_MANAGER_HH
+#define CHECKPOINT_MANAGER_HH
+
+#include "RunSnapshot.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class G4GenericMessenger;
+class RunAction;
+
+// ============================================================================
+// CheckpointManager Class Declaration
+// ============================================================================
+/**
+ * @class CheckpointManager
+ * @brief Crash-safe partial output: periodic checkpoints and resume.
+ *
+ * One instance per thread (Instance()). When enabled (/ats/checkpoint/events
+ * or /ats/checkpoint/seconds), a checkpoint is due every N events (counted
+ * over all threads) or every T seconds:
+ *  - each event-processing thread copies its histograms (G4AnalysisManager
+ *    H1), RunAction counters and RNG state into its SnapshotSlot at the end
+ *    of its next event, so a worker never waits for I/O;
+ *  - a writer thread started by the master merges the front buffers of all
+ *    threads, writes them to <file>.tmp.root and renames it to <file>.root,
+ *    so the checkpoint on disk is always complete.
+ *
+ * /ats/checkpoint/resume <file> (master) reads a checkpoint: the RNG engine
+ * is restored, and at the beginning of the next run the histogram contents
+ * and counters are added to the new run's. The remaining events are then
+ * simulated with /run/beamOn. The new run starts again at event ID 0, so the
+ * checkpoint also stores the global index past the last completed event
+ * (event offset plus event ID), and the resume sets /ats/seed/eventOffset to
+ * it: per-event seeds (/ats/seed/perEvent) and BeamProfile samples of the
+ * resumed events then differ from those already in the checkpoint. Events in
+ * flight at the checkpoint are skipped, not repeated.
+ *
+ * Resumes can be chained (crash, resume, crash, resume): the resumed state is
+ * kept as the base of the run, and every later checkpoint holds the base plus
+ * the new events, with "events" and "next_event" counting both.
+ *
+ * Configured via the /ats/checkpoint/ UI directory.
+ */
+class CheckpointManager
+{
+  public:
+	/**
+	 * @brief Returns the instance of the calling thread (created on first use).
+	 */
+	static CheckpointManager *Instance();
+
+	/**
+	 * @brief Destructor. Stops the writer thread if it is still running.
+	 */
+	~CheckpointManager();
+
+	/**
+	 * @brief Returns true if periodic checkpoints are enabled.
+	 */
+	G4bool IsEnabled() const { return fEveryEvents > 0 || fEverySeconds > 0.; }
+
+	/**
+	 * @brief Applies a pending resume (master) and starts checkpointing for the run.
+	 * @param runAction Run action of the calling thread.
+	 * @param master True on the master (or sequential) thread.
+	 * @param processing True on threads that process events.
+	 */
+	void BeginOfRun(RunAction *runAction, G4bool master, G4bool processing);
+
+	/**
+	 * @brief Counts a finished event and publishes a snapshot if one is requested.
+	 * @param runAction Run action of the calling thread (source of the counters).
+	 * @param eventID ID of the finished event within the run.
+	 */
+	void EndOfEvent(const RunAction *runAction, G4int eventID);
+
+	/**
+	 * @brief Stops checkpointing for the run (writer thread on the master).
+	 * @param master True on the master (or sequential) thread.
+	 */
+	void EndOfRun(G4bool master);
+
+  private:
+	/// Private constructor: use Instance().
+	CheckpointManager();
+
+	/// Fills the back buffer and swaps it in (never blocks).
+	void Publish(const RunAction *runAction, G4long generation);
+
+	/// Writer thread: waits for requests (or the timer) and writes checkpoints.
+	void WriterLoop();
+
+	/// Merges the front buffers and writes the checkpoint file.
+	void Write(G4long generation);
+
+	/// Reads a checkpoint and restores the RNG; the rest is applied at the next run.
+	void Resume(const G4String &fileName);
+
+	/// Adds the resumed histograms and counters to the new run and keeps them as the base (master).
+	void ApplyResume(RunAction *runAction);
+
+	/// Declares the /ats/checkpoint/ UI commands.
+	void DefineCommands();
+
+	/// Checkpoint every N events over all threads (0: off).
+	G4int fEveryEvents = 0;
+
+	/// Checkpoint every T seconds (0: off).
+	G4double fEverySeconds = 0.;
+
+	/// Base name of the checkpoint file.
+	G4String fFileName = "muon_checkpoint";
+
+	/// Snapshot slot of this thread (processing threads only).
+	std::unique_ptr<SnapshotSlot> fSlot;
+
+	/// Last checkpoint generation published by this thread.
+	G4long fPublished = -1;
+
+	/// Events processed by this thread in the current run.
+	G4long fNumEvents = 0;
+
+	/// Global index past the last event completed by this thread.
+	G4long fNextEvent = 0;
+
+	/// Checkpoint read by /ats/checkpoint/resume, applied at the next run.
+	std::unique_ptr<RunSnapshot> fResume;
+
+	/// Writer thread (master instance only).
+	std::thread fWriter;
+
+	/// Slots of all event-processing threads (shared).
+	static SnapshotSlots fSlots;
+
+	/// Resumed state of the current run, included in every checkpoint (shared, set before the writer starts).
+	static std::unique_ptr<RunSnapshot> fBase;
+
+	/// The base is not part of any thread's snapshot (MT: it lives on the master, which has no slot).
+	static G4bool fBaseSeparate;
+
+	/// Guards the writer wake-up.
+	static std::mutex fMutex;
+	static std::condition_variable fWake;
+
+	/// Events over all threads, requested and written generations (shared).
+	static std::atomic<G4long> fEventsDone;
+	static std::atomic<G4long> fRequested;
+	static std::atomic<G4bool> fStop;
+
+	/// Settings shared with the writer thread (copied from the master at run start).
+	static G4String fOutputName;
+	static G4double fPeriod;
+
+	/// UI messenger for the /ats/checkpoint/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
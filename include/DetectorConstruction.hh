@@ -12,6 +12,7 @@
 #define DETECTOR_CONSTRUCTION_HH
 
 #include "G4LogicalVolume.hh"
+#include "G4ThreeVector.hh"
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
 #include <string>
@@ -37,6 +38,11 @@ class DetectorConstruction : public G4VUserDetectorConstruction
 	 */
 	virtual G4VPhysicalVolume *Construct() override;
 
+	/**
+	 * @brief Attaches the sensitive detector and magnetic fields (called once per thread).
+	 */
+	virtual void ConstructSDandField() override;
+
 	// ==== Public Methods ====
 
 	/**
@@ -45,12 +51,24 @@ class DetectorConstruction : public G4VUserDetectorConstruction
 	 */
 	void SetDetectorType(const G4String &type);
 
+	/**
+	 * @brief Returns the type of detector being constructed.
+	 */
+	const G4String &GetDetectorType() const { return fDetectorType; }
+
 	/**
 	 * @brief Access to the scoring volume.
 	 * @return Pointer to the logical volume used for scoring.
 	 */
 	G4LogicalVolume *GetScoringVolume() const { return fScoringVolume; }
 
+	/**
+	 * @brief Access to the graphite proton target (ProtonTargetLV) where pions are produced.
+	 * @return Pointer to the production target, or nullptr for geometries without one
+	 *         (carbonStack, alternatingLayers).
+	 */
+	G4LogicalVolume *GetProductionTargetVolume() const { return fProductionTargetVolume; }
+
 	/**
 	 * @brief Accessor for the target volume corresponding to a given index.
 	 * @param n Index of the requested target volume (e.g., plate or layer index).
@@ -94,6 +112,33 @@ class DetectorConstruction : public G4VUserDetectorConstruction
 	 */
 	G4double GetDTZCenter() const { return fDTZCenter; }
 
+	/**
+	 * @brief Returns the Z-position of the back face of the last converter (Converter_N).
+	 *
+	 * Together with GetDTZStart() this bounds the drift region where muons travel
+	 * from the converter stack to the D-T cell; used to define importance cells.
+	 *
+	 * @return Z-position [G4double] in global coordinates (0 if the geometry has no converter stack).
+	 */
+	G4double GetConverterZEnd() const { return fConverterZEnd; }
+
+	/**
+	 * @brief Returns the lower corner of the apparatus envelope.
+	 *
+	 * The envelope is the axis-aligned box enclosing every daughter of the world
+	 * volume (targets, converters, D-T cell). Anything outside it is surrounded
+	 * only by world air.
+	 *
+	 * @return Minimum (x, y, z) corner in global coordinates.
+	 */
+	G4ThreeVector GetEnvelopeMin() const { return fEnvelopeMin; }
+
+	/**
+	 * @brief Returns the upper corner of the apparatus envelope.
+	 * @return Maximum (x, y, z) corner in global coordinates.
+	 */
+	G4ThreeVector GetEnvelopeMax() const { return fEnvelopeMax; }
+
   private:
 	// ==== Private Members ====
 
@@ -112,7 +157,25 @@ class DetectorConstruction : public G4VUserDetectorConstruction
 	 */
 	G4double fDTZCenter = 0.;
 
+	/**
+	 * @brief Z of the back face of the last converter.
+	 */
+	G4double fConverterZEnd = 0.;
+
+	/**
+	 * @brief Corners of the box enclosing all world daughters (see GetEnvelopeMin()).
+	 */
+	G4ThreeVector fEnvelopeMin;
+	G4ThreeVector fEnvelopeMax;
+
 	G4LogicalVolume *fScoringVolume = nullptr;
+	G4LogicalVolume *fProductionTargetVolume = nullptr;
+
+	/// D-T gas volume that receives the local magnetic field (nullptr if absent).
+	G4LogicalVolume *fDTVolume = nullptr;
+
+	/// Apply the uniform field to the whole world instead of the D-T gas only.
+	G4bool fGlobalField = false;
 	G4String fDetectorType = "carbonStack"; // default
 
 	// Target layers or absorbers for muon interaction and diagnostics
@@ -159,6 +222,12 @@ class DetectorConstruction : public G4VUserDetectorConstruction
 	 * @return Pointer to the constructed physical volume.
 	 */
 	G4VPhysicalVolume *ConstructOpenMuonTarget();
+
+	/**
+	 * @brief Computes the apparatus envelope from the daughters of the world volume.
+	 * @param world Pointer to the world physical volume returned by a Construct*() method.
+	 */
+	void ComputeEnvelope(const G4VPhysicalVolume *world);
 };
 // ============================================================================
 
@@ -0,0 +1,134 @@
+// ============================================================================
+//  File   : EarlyAbortPolicy.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the EarlyAbortPolicy class, an opt-in event filter that
+//           aborts events once every hadron has left the production target
+//           without producing a muon or a particle that may decay into one.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef EARLY_ABORT_POLICY_HH
+#define EARLY_ABORT_POLICY_HH
+
+#include "globals.hh"
+
+#include <unordered_set>
+
+class G4GenericMessenger;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4Step;
+
+// ============================================================================
+// EarlyAbortPolicy Class Declaration
+// ============================================================================
+/**
+ * @class EarlyAbortPolicy
+ * @brief Aborts events whose production-target stage yields no muon precursor.
+ *
+ * The policy keeps a per-event count of energetic hadrons (above the pion
+ * production threshold) that are inside ProtonTargetLV:
+ *  - +1 when such a hadron enters the target or is created inside it,
+ *  - -1 when it leaves the target or ends inside it.
+ *
+ * When the count drops back to zero and no muon precursor (a muon or a particle
+ * that may decay into one, see MuonAncestry) has been seen, the event is
+ * aborted with G4EventManager::AbortCurrentEvent(). Any bookkeeping mismatch
+ * leaves the count above zero, so the policy can only fail towards not aborting.
+ *
+ * With several primaries per event (/ats/gun/primariesPerEvent) the count
+ * may only reach zero for good once every primary has started tracking, so the
+ * abort waits for the last primary. An aborted event then drops all of its
+ * primaries, none of which produced a precursor.
+ *
+ * Aborted events still count as processed events in G4Run, so yields per proton
+ * remain normalized to the number of events (and primaries); RunAction reports
+ * how many of them were aborted. The policy only applies to geometries with a production target
+ * (muonTarget, openMuonTarget) and is inactive in sub-event parallel mode, where
+ * the shower of an event may still be tracked on other threads.
+ *
+ * Configured via the /ats/abort/ UI directory.
+ */
+class EarlyAbortPolicy
+{
+  public:
+	/**
+	 * @brief Constructor. Registers the UI commands; the policy starts disabled.
+	 */
+	EarlyAbortPolicy();
+
+	/**
+	 * @brief Destructor.
+	 */
+	~EarlyAbortPolicy();
+
+	/**
+	 * @brief Returns true if the policy is enabled.
+	 */
+	G4bool IsEnabled() const { return fEnabled; }
+
+	/**
+	 * @brief Clears the per-event state. Called from EventAction::BeginOfEventAction().
+	 * @param nPrimaries Number of primaries of the event.
+	 */
+	void BeginEvent(G4int nPrimaries = 1);
+
+	/**
+	 * @brief Updates the target bookkeeping for one step and aborts the event if due.
+	 * @param step Pointer to the current G4Step.
+	 */
+	void ProcessStep(const G4Step *step);
+
+	/**
+	 * @brief Returns true if the policy aborted the current event.
+	 */
+	G4bool AbortedThisEvent() const { return fAborted; }
+
+  private:
+	/// Returns true for muons and the particles that may decay into one (MuonAncestry).
+	G4bool IsPrecursor(const G4ParticleDefinition *particle) const;
+
+	/// Returns true for hadrons able to produce pions at the given kinetic energy.
+	G4bool IsEnergeticHadron(const G4ParticleDefinition *particle, G4double kineticEnergy) const;
+
+	/// Declares the /ats/abort/ UI commands.
+	void DefineCommands();
+
+	/// Opt-in switch.
+	G4bool fEnabled = false;
+
+	/// Hadrons below this kinetic energy cannot produce pions and are ignored.
+	G4double fHadronThreshold;
+
+	/// Production target, looked up from the geometry on first use.
+	G4LogicalVolume *fTarget = nullptr;
+	G4bool fTargetResolved = false;
+
+	/// Energetic hadrons currently inside the target (per event).
+	G4int fPending = 0;
+
+	/// Whether any hadron was ever counted this event.
+	G4bool fArmed = false;
+
+	/// Primaries of the current event, and how many of them have started tracking.
+	G4int fNumPrimaries = 1;
+	G4int fPrimariesStarted = 0;
+
+	/// A muon precursor (MuonAncestry::IsMuonAncestor()) was seen this event.
+	G4bool fPrecursorSeen = false;
+
+	/// The policy aborted the current event.
+	G4bool fAborted = false;
+
+	/// Track IDs of counted hadrons currently inside the target.
+	std::unordered_set<G4int> fInside;
+
+	/// UI messenger for the /ats/abort/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
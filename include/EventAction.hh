@@ -18,6 +18,16 @@
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 
+#include <vector>
+
+class CheckpointManager;
+class EarlyAbortPolicy;
+class EventDisplayWriter;
+class KeptEventManager;
+class LiveMonitor;
+class PerfCounters;
+class SlowEventMonitor;
+
 /**
  * @class EventAction
  * @brief Handles logic to selectively retain Geant4 events for visualization.
@@ -25,6 +35,9 @@
  * This class allows user control over which events are kept for visualization
  * in the Geant4 GUI viewer (limited to 100 events by default). In this project,
  * we use it to keep only events where at least one muon was produced.
+ * It also owns the per-event state of the early-abort policy and the
+ * KeptEventManager that bounds how many of those events are kept, and counts
+ * the muons of each primary when an event carries several of them.
  */
 class EventAction : public G4UserEventAction
 {
@@ -59,9 +72,86 @@ class EventAction : public G4UserEventAction
 	 */
 	void SetKeepEvent(bool keep);
 
+	/**
+	 * @brief Records a muon stop in the D-T gas (the event is preferred when keeping events).
+	 * @param weight Statistical weight of the muon, added to the D-T stop tally of the event.
+	 */
+	void RecordMuonStopInDT(G4double weight)
+	{
+		fMuonStopInDT = true;
+		fDTStopWeight += weight;
+	}
+
+	/**
+	 * @brief Access to the early-abort policy (updated step by step by SteppingAction).
+	 * @return Pointer to the policy owned by this action.
+	 */
+	EarlyAbortPolicy *GetEarlyAbortPolicy() const { return fEarlyAbortPolicy; }
+
+	/**
+	 * @brief Counts one transport step of the current event (called by SteppingAction).
+	 */
+	void CountStep() { ++fNumSteps; }
+
+	/**
+	 * @brief Maps a new track to the primary it descends from (called by TrackingAction).
+	 * @param trackID ID of the track about to be transported.
+	 * @param parentID ID of its parent (0 for primaries).
+	 */
+	void RecordTrack(G4int trackID, G4int parentID);
+
+	/**
+	 * @brief Credits a newly created muon to the primary it descends from (called by SteppingAction).
+	 * @param trackID Track ID of the muon.
+	 * @param weight Statistical weight of the muon.
+	 */
+	void RecordMuon(G4int trackID, G4double weight);
+
   private:
 	/// Flag indicating whether this event should be retained.
 	bool fKeepThisEvent;
+
+	/// The current event is a sub-event of sub-event parallel mode.
+	G4bool fSubEvent = false;
+
+	/// A muon stopped in the D-T gas in this event.
+	G4bool fMuonStopInDT = false;
+
+	/// Weighted muon stops in the D-T gas in this event (figure of merit).
+	G4double fDTStopWeight = 0.;
+
+	/// Reservoir sampling of the events flagged for retention.
+	KeptEventManager *fKeptEventManager = nullptr;
+
+	/// Weighted muons created per primary of the current event (one slot per primary vertex).
+	std::vector<G4double> fMuonsPerPrimary;
+
+	/// Primary index per track ID of the current event (several primaries only; -1: unknown).
+	std::vector<G4int> fPrimaryOfTrack;
+
+	/// Weighted muons created in the current sub-event (no primary to credit them to).
+	G4double fSubEventMuons = 0.;
+
+	/// Steps taken in the current event, handed to RunAction at the end of the event.
+	G4long fNumSteps = 0;
+
+	/// Opt-in abort of events without muon precursors from the production target.
+	EarlyAbortPolicy *fEarlyAbortPolicy = nullptr;
+
+	/// Hardware counters of this thread (not owned).
+	PerfCounters *fPerfCounters = nullptr;
+
+	/// Slow-event timer of this thread (not owned).
+	SlowEventMonitor *fSlowEventMonitor = nullptr;
+
+	/// Offline event-display writer of this thread (not owned).
+	EventDisplayWriter *fEventDisplayWriter = nullptr;
+
+	/// Checkpoint snapshots of this thread (not owned).
+	CheckpointManager *fCheckpointManager = nullptr;
+
+	/// Live monitor snapshots of this thread (not owned).
+	LiveMonitor *fLiveMonitor = nullptr;
 };
 // ============================================================================
 
@@ -0,0 +1,78 @@
+// ============================================================================
+//  File   : EventDisplayFormat.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Describes the compact binary event-display file (.atsd) shared by
+//           the EventDisplayWriter and the ats_display viewer/exporter.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef EVENT_DISPLAY_FORMAT_HH
+#define EVENT_DISPLAY_FORMAT_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @namespace EventDisplayFormat
+ * @brief Layout of the .atsd event-display file (no Geant4 dependency).
+ *
+ * All values are little-endian (converted with ToFileOrder() on big-endian
+ * hosts); positions are float32 in mm.
+ * @code
+ * file       := header event*
+ * header     := "ATSD" uint32 version
+ * event      := int32 runID, int32 eventID, uint32 nTrajectories, trajectory*
+ * trajectory := int32 trackID, int32 parentID, int32 pdg, uint8 processTag,
+ *               uint32 nPoints, float32[3] first point,
+ *               (nPoints - 1) x float32[3] difference to the previous point
+ * @endcode
+ * Differences are taken from the previous point as reconstructed in float32,
+ * so summing them never drifts from the stored first point.
+ */
+namespace EventDisplayFormat
+{
+/// File signature.
+constexpr char kMagic[4] = {'A', 'T', 'S', 'D'};
+
+/// Format version written in the header.
+constexpr std::uint32_t kVersion = 1;
+
+/// How the track was created (coarse G4ProcessType of the creator process).
+enum ProcessTag : std::uint8_t
+{
+	kPrimary = 0,
+	kDecay,
+	kHadronic,
+	kElectromagnetic,
+	kOther,
+	kNumProcessTags
+};
+
+/// Converts a value between host and file (little-endian) byte order; its own inverse.
+template <typename T>
+inline T ToFileOrder(T value)
+{
+	const std::uint16_t probe = 1;
+	if (*reinterpret_cast<const unsigned char *>(&probe) == 1)
+		return value;
+
+	unsigned char bytes[sizeof(T)];
+	std::memcpy(bytes, &value, sizeof(T));
+	std::reverse(bytes, bytes + sizeof(T));
+	std::memcpy(&value, bytes, sizeof(T));
+	return value;
+}
+
+/// Returns a printable name of a process tag.
+inline const char *GetProcessTagName(std::uint8_t tag)
+{
+	static const char *names[kNumProcessTags] = {"primary", "decay", "hadronic", "em", "other"};
+	return tag < kNumProcessTags ? names[tag] : "unknown";
+}
+} // namespace EventDisplayFormat
+
+#endif
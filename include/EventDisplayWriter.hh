@@ -0,0 +1,118 @@
+// ============================================================================
+//  File   : EventDisplayWriter.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the EventDisplayWriter class, which writes the
+//           trajectories of muon events to a compact binary file for offline
+//           display (see EventDisplayFormat.hh and tools/ats_display.cc).
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef EVENT_DISPLAY_WRITER_HH
+#define EVENT_DISPLAY_WRITER_HH
+
+#include "EventDisplayFormat.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+class G4Event;
+class G4GenericMessenger;
+class G4Track;
+
+// ============================================================================
+// EventDisplayWriter Class Declaration
+// ============================================================================
+/**
+ * @class EventDisplayWriter
+ * @brief Per-thread writer of the .atsd event-display file.
+ *
+ * When enabled (/ats/display/enable), EventAction hands over every muon event
+ * it flags for retention and the writer appends the event's trajectories to
+ * <file>[_t<thread>].atsd: float32, delta-encoded points tagged with the PDG
+ * code and the kind of creator process. TrackingAction reports the creator of
+ * each track through RecordTrack(), since not every trajectory type keeps it.
+ *
+ * Trajectories must be stored (/tracking/storeTrajectory); combined with
+ * /ats/traj/select only the muon chain is written. The files are read by the
+ * ats_display tool, which lists events and exports them to VRML.
+ *
+ * Configured via the /ats/display/ UI directory.
+ */
+class EventDisplayWriter
+{
+  public:
+	/**
+	 * @brief Returns the writer of the calling thread (created on first use).
+	 */
+	static EventDisplayWriter *Instance();
+
+	/**
+	 * @brief Destructor. Closes the file.
+	 */
+	~EventDisplayWriter();
+
+	/**
+	 * @brief Returns true if the event display output is enabled.
+	 */
+	G4bool IsEnabled() const { return fEnabled; }
+
+	/**
+	 * @brief Clears the per-event creator tags.
+	 */
+	void BeginEvent() { fProcessTags.clear(); }
+
+	/**
+	 * @brief Records the creator process of a new track (called by TrackingAction when enabled).
+	 */
+	void RecordTrack(const G4Track *track);
+
+	/**
+	 * @brief Appends the trajectories of an event to the file.
+	 * @param event Finished event; nothing is written without a trajectory container.
+	 */
+	void WriteEvent(const G4Event *event);
+
+  private:
+	/// Private constructor: use Instance().
+	EventDisplayWriter();
+
+	/// Opens the output file of this thread and writes the header.
+	void Open();
+
+	/// Writes a trivially copyable value in the little-endian file order.
+	template <typename T>
+	void Put(T value)
+	{
+		value = EventDisplayFormat::ToFileOrder(value);
+		fOutput.write(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	/// Declares the /ats/display/ UI commands.
+	void DefineCommands();
+
+	/// Opt-in switch.
+	G4bool fEnabled = false;
+
+	/// Base name of the output file.
+	G4String fFileName = "muon_events";
+
+	/// Creator tag per track ID of the current event.
+	std::vector<std::uint8_t> fProcessTags;
+
+	/// Events written by this thread.
+	G4long fNumEvents = 0;
+
+	/// Output stream (opened on the first event).
+	std::ofstream fOutput;
+
+	/// UI messenger for the /ats/display/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
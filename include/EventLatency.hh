@@ -0,0 +1,109 @@
+// ============================================================================
+//  File   : EventLatency.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the EventLatency class, which measures the wall time of
+//           each event inside the run, from its first user action to the end
+//           of its last sub-event.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef EVENT_LATENCY_HH
+#define EVENT_LATENCY_HH
+
+#include "globals.hh"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+
+// ============================================================================
+// EventLatency Class Declaration
+// ============================================================================
+/**
+ * @class EventLatency
+ * @brief In-run event latency, including the sub-events of an event.
+ *
+ * EventAction reports the beginning of every event and the end of every event
+ * and sub-event. The latency of an event is the time from its
+ * BeginOfEventAction() to the latest EndOfEventAction() with its event ID:
+ * in sub-event parallel mode the sub-events carry the event ID of their
+ * parent, so the shipped shower tracks are included. Run start-up (output
+ * files, sidecar, worker start) and run end are not.
+ *
+ * Off by default (the benchmark enables it); events are kept until Reset().
+ */
+class EventLatency
+{
+  public:
+	/**
+	 * @brief Enables or disables the measurement.
+	 */
+	static void SetEnabled(G4bool enabled) { fEnabled = enabled; }
+
+	/**
+	 * @brief Returns true if the measurement is enabled.
+	 */
+	static G4bool IsEnabled() { return fEnabled; }
+
+	/**
+	 * @brief Starts the clock of an event (not called for sub-events).
+	 * @param eventID ID of the event.
+	 */
+	static void BeginEvent(G4int eventID);
+
+	/**
+	 * @brief Moves the end of an event to now (event or one of its sub-events).
+	 * @param eventID ID of the event (of the parent for sub-events).
+	 */
+	static void EndEvent(G4int eventID);
+
+	/**
+	 * @brief Forgets all events (before a run whose latencies are read afterwards).
+	 */
+	static void Reset();
+
+	/**
+	 * @brief Returns the number of events with a measured latency.
+	 */
+	static G4int GetNumberOfEvents();
+
+	/**
+	 * @brief Returns the mean latency [s] of the measured events (0 if none).
+	 */
+	static G4double GetMeanSeconds();
+
+	/**
+	 * @brief Returns the longest latency [s] of the measured events (0 if none).
+	 */
+	static G4double GetMaxSeconds();
+
+  private:
+	using Clock = std::chrono::steady_clock;
+
+	/// Static interface only.
+	EventLatency() = delete;
+
+	/// Start of an event and end of its last finished part.
+	struct Interval
+	{
+		Clock::time_point start;
+		Clock::time_point end;
+		G4bool ended = false;
+	};
+
+	/// Measurement enabled.
+	static std::atomic<G4bool> fEnabled;
+
+	/// Guards fEvents (updated by all threads).
+	static std::mutex fMutex;
+
+	/// Interval per event ID.
+	static std::map<G4int, Interval> fEvents;
+};
+// ============================================================================
+
+#endif
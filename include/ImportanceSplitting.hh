@@ -0,0 +1,118 @@
+// ============================================================================
+//  File   : ImportanceSplitting.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the ImportanceSplitting class, a geometric importance
+//           biasing scheme (splitting / Russian roulette) for muons and pions
+//           drifting from the converter stack toward the D-T gas cell.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef IMPORTANCE_SPLITTING_HH
+#define IMPORTANCE_SPLITTING_HH
+
+#include "G4TrackVector.hh"
+#include "globals.hh"
+
+class DetectorConstruction;
+class G4GenericMessenger;
+class G4ParticleDefinition;
+class G4Step;
+
+// ============================================================================
+// ImportanceSplitting Class Declaration
+// ============================================================================
+/**
+ * @class ImportanceSplitting
+ * @brief Geometric importance biasing along z toward the D-T cell.
+ *
+ * The drift region between the back face of the last converter and the front
+ * face of the D-T cell is divided into N slabs of equal thickness. Cell 0 is
+ * everything upstream of the drift region, cells 1..N are the slabs and cell
+ * N+1 is the D-T cell and beyond. Cell c has importance r^c.
+ *
+ * N is the requested number of slabs, reduced so that no slab is thinner than
+ * the minimum width: muons cross a thin slab stack in a step or two, so the
+ * crossings collapse into one large split of strongly correlated copies. A
+ * drift region thinner than the minimum width (about 1 mm in the default
+ * geometry) disables the biasing, with a warning. RunAction reports the figure
+ * of merit of the D-T stop tally, so settings can be compared.
+ *
+ * When a muon or charged pion crosses from cell a to cell b:
+ *  - b > a: the track is split into r^(b-a) copies (randomized for non-integer
+ *    ratios), each carrying weight w / r^(b-a);
+ *  - b < a: Russian roulette; the track survives with probability r^(b-a) and
+ *    its weight becomes w * r^(a-b).
+ *
+ * The expected total weight is conserved, so every histogram filled with the
+ * track weight stays unbiased while D-T stop statistics grow with r^(N+1).
+ * Copies are marked through TrackInformation so their first step is not scored
+ * as a muon creation; roulette victims are marked so their end is not scored as
+ * a muon stop.
+ *
+ * This is the stepping-action equivalent of G4ImportanceBiasing with a parallel
+ * world of z slabs; it avoids one biasing physics constructor per particle type.
+ *
+ * Configured via the /ats/bias/ UI directory.
+ */
+class ImportanceSplitting
+{
+  public:
+	/**
+	 * @brief Constructor.
+	 * @param detectorConstruction Pointer to the geometry (converter and D-T positions).
+	 */
+	ImportanceSplitting(const DetectorConstruction *detectorConstruction);
+
+	/**
+	 * @brief Destructor.
+	 */
+	~ImportanceSplitting();
+
+	/**
+	 * @brief Applies splitting or Russian roulette when the step crosses cell boundaries.
+	 * @param step Pointer to the current G4Step.
+	 * @param secondaries Secondary vector of the stepping manager; clones are appended here.
+	 * @return True if the track lost the Russian roulette and was killed.
+	 */
+	G4bool Apply(const G4Step *step, G4TrackVector *secondaries);
+
+  private:
+	/// Returns the number of slabs that fit in the drift region (0: no biasing).
+	G4int GetNumberOfSlabs() const;
+
+	/// Returns the importance cell index of a z position.
+	G4int GetCell(G4double z, G4int nSlabs) const;
+
+	/// Returns true for particles subject to biasing (muons, charged pions).
+	G4bool IsBiased(const G4ParticleDefinition *particle) const;
+
+	/// Declares the /ats/bias/ UI commands.
+	void DefineCommands();
+
+	/// Pointer to detector construction class to access the drift region.
+	const DetectorConstruction *fDetectorConstruction;
+
+	/// Enables biasing.
+	G4bool fEnabled = false;
+
+	/// Number of slabs between the last converter and the D-T cell.
+	G4int fNumCells = 4;
+
+	/// Minimum slab thickness; fewer slabs are used in a thinner drift region.
+	G4double fMinCellWidth;
+
+	/// Importance ratio between adjacent cells.
+	G4double fRatio = 2.;
+
+	/// Upper limit on copies created in a single crossing.
+	G4int fMaxSplit = 64;
+
+	/// UI messenger for the /ats/bias/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
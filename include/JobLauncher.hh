@@ -0,0 +1,113 @@
+// ============================================================================
+//  File   : JobLauncher.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the JobLauncher class, which forks independent
+//           simulation processes with non-overlapping random streams, retries
+//           crashed ones and merges their output files.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef JOB_LAUNCHER_HH
+#define JOB_LAUNCHER_HH
+
+#include "globals.hh"
+
+#include <vector>
+
+class G4UImanager;
+
+// ============================================================================
+// JobLauncher Class Declaration
+// ============================================================================
+/**
+ * @class JobLauncher
+ * @brief Multi-process fan-out on one node (`active_target_sim --jobs N -n EVENTS`).
+ *
+ * Fork() is called before any Geant4 object exists. The parent forks one
+ * process per job and waits; each child returns from Fork() with its job
+ * index, builds the simulation as usual and calls RunJob(), which:
+ *  - executes the setup macro (which must not contain /run/beamOn),
+ *  - appends _job{job} to the output name template and sets /ats/output/job,
+ *  - seeds the engine with /random/setSeeds <master seed> <job + 1> (MixMax,
+ *    the default engine, derives non-overlapping streams from distinct seed
+ *    tuples),
+ *  - sets /ats/seed/master and /ats/seed/eventOffset: the offset moves the
+ *    job to its own range of BeamProfile samples (the /ats/beam/seed blocks
+ *    are shared, the sample indices are global), and with /ats/seed/perEvent
+ *    also of engine seeds, so the merged result does not depend on N,
+ *  - runs its share of the events and reports its output file to the parent.
+ *
+ * A job that crashes (signal or non-zero exit) is restarted with the same
+ * seeds, up to a retry limit. When all jobs are done, the parent merges their
+ * output files into one (TFileMerger). SIGINT/SIGTERM reach the children,
+ * which stop gracefully (RunInterrupt); their partial outputs are merged.
+ */
+class JobLauncher
+{
+  public:
+	/**
+	 * @brief Constructor.
+	 * @param nJobs Number of processes.
+	 * @param nEvents Total number of events, split evenly over the jobs.
+	 * @param masterSeed Seed from which the job streams are derived (> 0).
+	 * @param maxRetries Restarts allowed per crashed job.
+	 */
+	JobLauncher(G4int nJobs, G4long nEvents, G4long masterSeed, G4int maxRetries);
+
+	/**
+	 * @brief Forks the jobs (POSIX only).
+	 * @return The job index in a child; -1 in the parent once every job has
+	 *         finished and the outputs are merged.
+	 */
+	G4int Fork();
+
+	/**
+	 * @brief Configures and runs the events of this job (child only).
+	 * @param uiManager UI manager of the child.
+	 * @param macro Setup macro executed first (may be empty).
+	 */
+	void RunJob(G4UImanager *uiManager, const G4String &macro);
+
+	/**
+	 * @brief Returns the exit code of the parent (0 if every job succeeded and the merge worked).
+	 */
+	G4int GetExitCode() const { return fExitCode; }
+
+  private:
+	/// Starts job k; returns its process ID in the parent (0 in the child).
+	G4int Start(G4int job);
+
+	/// Merges the job outputs into one file.
+	G4bool Merge(const std::vector<G4String> &outputs) const;
+
+	/// Number of events of job k.
+	G4long GetJobEvents(G4int job) const;
+
+	/// Number of processes.
+	G4int fNumJobs;
+
+	/// Total number of events.
+	G4long fNumEvents;
+
+	/// Seed from which the job streams are derived.
+	G4long fMasterSeed;
+
+	/// Restarts allowed per crashed job.
+	G4int fMaxRetries;
+
+	/// Index of this process's job (-1 in the parent).
+	G4int fJob = -1;
+
+	/// Write end of the pipe reporting the output name (child), read ends per job (parent).
+	G4int fReportFd = -1;
+	std::vector<G4int> fReadFds;
+
+	/// Exit code of the parent.
+	G4int fExitCode = 0;
+};
+// ============================================================================
+
+#endif
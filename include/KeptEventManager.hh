@@ -0,0 +1,113 @@
+// ============================================================================
+//  File   : KeptEventManager.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the KeptEventManager class, which bounds the number of
+//           events kept for visualization with reservoir sampling and can
+//           favour events with a muon stopping in the D-T cell.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef KEPT_EVENT_MANAGER_HH
+#define KEPT_EVENT_MANAGER_HH
+
+#include "globals.hh"
+
+#include <random>
+#include <vector>
+
+class G4Event;
+class G4GenericMessenger;
+
+// ============================================================================
+// KeptEventManager Class Declaration
+// ============================================================================
+/**
+ * @class KeptEventManager
+ * @brief Keeps a uniform sample of at most K muon events per run and thread.
+ *
+ * Every event flagged by EventAction is offered with Offer(). The manager keeps
+ * a reservoir of K slots (Algorithm R): the n-th candidate is kept with
+ * probability K/n and replaces a random slot. The event it replaces is removed
+ * from the Run and deleted soon after, trajectories included (see Run), so
+ * memory stays bounded however long the run is.
+ *
+ * With D-T priority enabled, events with a muon stop in the D-T gas displace
+ * ordinary muon events first and are then sampled among themselves; ordinary
+ * events are sampled into the slots that remain.
+ *
+ * Sampling uses its own generator so the physics random stream is untouched.
+ * Configured via the /ats/keep/ UI directory; a maximum of 0 keeps every
+ * flagged event (the previous behaviour).
+ */
+class KeptEventManager
+{
+  public:
+	/**
+	 * @brief Constructor. Registers the UI commands.
+	 */
+	KeptEventManager();
+
+	/**
+	 * @brief Destructor.
+	 */
+	~KeptEventManager();
+
+	/**
+	 * @brief Decides whether the current event is kept, releasing the event it replaces.
+	 * @param event Event being finished (EndOfEventAction).
+	 * @param muonStopInDT True if a muon stopped in the D-T gas in this event.
+	 * @return True if the event should be kept (KeepTheCurrentEvent()).
+	 */
+	G4bool Offer(const G4Event *event, G4bool muonStopInDT);
+
+  private:
+	/// One reservoir slot.
+	struct Slot
+	{
+		const G4Event *event = nullptr;
+		G4bool priority = false;
+	};
+
+	/// Clears the reservoir when a new run has started.
+	void CheckRun();
+
+	/// Returns a uniform integer in [0, n).
+	G4long Draw(G4long n) { return std::uniform_int_distribution<G4long>(0, n - 1)(fEngine); }
+
+	/// Returns the index of a random slot with the given priority (-1 if none).
+	G4int PickSlot(G4bool priority);
+
+	/// Releases the event in a slot and stores the new one.
+	void Replace(G4int slot, const G4Event *event, G4bool priority);
+
+	/// Declares the /ats/keep/ UI commands.
+	void DefineCommands();
+
+	/// Maximum number of kept events per run and thread (0: unlimited).
+	G4int fMaxEvents = 100;
+
+	/// Favour events with a muon stop in the D-T gas.
+	G4bool fPreferDT = true;
+
+	/// Reservoir of kept events.
+	std::vector<Slot> fSlots;
+
+	/// Candidates offered in this run (ordinary and D-T priority).
+	G4long fNumOffered = 0;
+	G4long fNumOfferedDT = 0;
+
+	/// Run the reservoir belongs to.
+	G4int fRunID = -1;
+
+	/// Private generator for the sampling decisions.
+	std::mt19937_64 fEngine;
+
+	/// UI messenger for the /ats/keep/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
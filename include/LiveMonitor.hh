@@ -0,0 +1,145 @@
+// ============================================================================
+//  File   : LiveMonitor.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the LiveMonitor class, which serves periodic snapshots
+//           of the merged histograms and throughput counters of a running
+//           job as JSON on a local Unix-domain socket.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef LIVE_MONITOR_HH
+#define LIVE_MONITOR_HH
+
+#include "RunSnapshot.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+class G4GenericMessenger;
+class RunAction;
+
+// ============================================================================
+// LiveMonitor Class Declaration
+// ============================================================================
+/**
+ * @class LiveMonitor
+ * @brief Read-only live view of a running job (histograms, counters, throughput).
+ *
+ * One instance per thread (Instance()). When enabled (/ats/monitor/enable),
+ * the master starts a server thread listening on a Unix-domain socket
+ * (/ats/monitor/socket, local connections only). Every /ats/monitor/interval
+ * seconds the server asks for fresh snapshots:
+ *  - each event-processing thread copies its histograms and RunAction
+ *    counters into its SnapshotSlot at the end of its next event (the same
+ *    scheme as the checkpoints), so a worker never waits for a client;
+ *  - each client connection receives one JSON document with the merged front
+ *    buffers, the event count and the throughput, then the connection is
+ *    closed. Example: `socat - UNIX-CONNECT:muon_monitor.sock`.
+ *
+ * Histograms are served with their in-range bins ("bins") and the underflow
+ * and overflow contents as separate fields; their entries give e.g. the D-T
+ * stop count (muonStopZ_DT). Configured via the /ats/monitor/ UI
+ * directory. POSIX only; elsewhere enabling it prints a warning.
+ */
+class LiveMonitor
+{
+  public:
+	/**
+	 * @brief Returns the instance of the calling thread (created on first use).
+	 */
+	static LiveMonitor *Instance();
+
+	/**
+	 * @brief Destructor. Stops the server thread if it is still running.
+	 */
+	~LiveMonitor();
+
+	/**
+	 * @brief Returns true if live monitoring is enabled.
+	 */
+	G4bool IsEnabled() const { return fEnabled; }
+
+	/**
+	 * @brief Starts the server (master) and registers the snapshot slot of a processing thread.
+	 * @param runID ID of the new run.
+	 * @param master True on the master (or sequential) thread.
+	 * @param processing True on threads that process events.
+	 */
+	void BeginOfRun(G4int runID, G4bool master, G4bool processing);
+
+	/**
+	 * @brief Counts a finished event and publishes a snapshot if one is requested.
+	 * @param runAction Run action of the calling thread (source of the counters).
+	 */
+	void EndOfEvent(const RunAction *runAction);
+
+	/**
+	 * @brief Withdraws the slot of this thread and stops the server (master).
+	 * @param master True on the master (or sequential) thread.
+	 */
+	void EndOfRun(G4bool master);
+
+  private:
+	/// Private constructor: use Instance().
+	LiveMonitor();
+
+	/// Fills the back buffer and swaps it in (never blocks).
+	void Publish(const RunAction *runAction, G4long generation);
+
+	/// Server thread: requests snapshots periodically and answers clients.
+	void ServerLoop(int listenFd, G4double interval);
+
+	/// Merges the front buffers and renders them as a JSON document.
+	std::string BuildJson() const;
+
+	/// Declares the /ats/monitor/ UI commands.
+	void DefineCommands();
+
+	/// Live monitoring enabled.
+	G4bool fEnabled = false;
+
+	/// Path of the Unix-domain socket.
+	G4String fSocketPath = "muon_monitor.sock";
+
+	/// Seconds between snapshot requests.
+	G4double fInterval = 2.;
+
+	/// Snapshot slot of this thread (processing threads only).
+	std::unique_ptr<SnapshotSlot> fSlot;
+
+	/// Last snapshot generation published by this thread.
+	G4long fPublished = -1;
+
+	/// Events processed by this thread in the current run.
+	G4long fNumEvents = 0;
+
+	/// Server thread (master instance only).
+	std::thread fServer;
+
+	/// Socket path bound by the server (master instance only).
+	std::string fBoundPath;
+
+	/// Slots of all event-processing threads (shared).
+	static SnapshotSlots fSlots;
+
+	/// Events over all threads and requested snapshot generation (shared).
+	static std::atomic<G4long> fEventsDone;
+	static std::atomic<G4long> fRequested;
+	static std::atomic<G4bool> fStop;
+
+	/// Run being monitored and its start time (steady clock, seconds).
+	static std::atomic<G4int> fRunID;
+	static std::atomic<G4double> fStartTime;
+
+	/// UI messenger for the /ats/monitor/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
@@ -0,0 +1,119 @@
+// ============================================================================
+//  File   : LooperControl.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the LooperControl class, which configures the looping-
+//           particle thresholds of the transportation and field propagator and
+//           detects tracks killed as loopers (e.g. in the D-T cell field).
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef LOOPER_CONTROL_HH
+#define LOOPER_CONTROL_HH
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+#include "globals.hh"
+
+#include <chrono>
+
+class G4GenericMessenger;
+
+// ============================================================================
+// LooperControl Class Declaration
+// ============================================================================
+/**
+ * @class LooperControl
+ * @brief Looper thresholds and looper-kill bookkeeping, one instance per thread.
+ *
+ * Charged particles below a few MeV spiral in the 1 T field of the D-T cell and
+ * can take thousands of field-propagation steps. G4Transportation kills such a
+ * "looper" when it has not finished its step after a number of trials and its
+ * energy is below the important-energy threshold (or immediately below the
+ * warning energy). ApplyThresholds() pushes the /ats/looper/ settings into the
+ * transportation process of every particle and into G4PropagatorInField; it is
+ * called at the beginning of every run because processes are thread-local.
+ *
+ * A looper kill is a step ending in fStopAndKill, limited by transportation,
+ * not at the world boundary and with kinetic energy left. StartTrack() stamps
+ * each track so the wall time spent on killed loopers can be reported.
+ *
+ * Configured via the /ats/looper/ UI directory. Negative values keep the
+ * Geant4 defaults.
+ */
+class LooperControl
+{
+  public:
+	/**
+	 * @brief Returns the instance of the calling thread (created on first use).
+	 */
+	static LooperControl *Instance();
+
+	/**
+	 * @brief Destructor.
+	 */
+	~LooperControl();
+
+	/**
+	 * @brief Applies the configured thresholds to this thread's transportation and propagator.
+	 */
+	void ApplyThresholds();
+
+	/**
+	 * @brief Stamps the start of a track (called by TrackingAction).
+	 */
+	void StartTrack() { fTrackStart = Clock::now(); }
+
+	/**
+	 * @brief Returns the wall time since StartTrack() [s].
+	 */
+	G4double GetTrackSeconds() const { return std::chrono::duration<G4double>(Clock::now() - fTrackStart).count(); }
+
+	/**
+	 * @brief Returns true if transportation killed the track as a looper in this step.
+	 * @param step Step just completed (checked before any user kill is applied).
+	 */
+	G4bool IsLooperKill(const G4Step *step) const
+	{
+		const G4Track *track = step->GetTrack();
+		if (track->GetTrackStatus() != fStopAndKill || track->GetKineticEnergy() <= 0.)
+			return false;
+
+		const G4StepPoint *post = step->GetPostStepPoint();
+		const G4VProcess *process = post->GetProcessDefinedStep();
+		return process && process->GetProcessType() == fTransportation && post->GetStepStatus() != fWorldBoundary;
+	}
+
+  private:
+	using Clock = std::chrono::steady_clock;
+
+	/// Private constructor: use Instance().
+	LooperControl();
+
+	/// Declares the /ats/looper/ UI commands.
+	void DefineCommands();
+
+	/// Below this energy a looper is killed without warning.
+	G4double fWarningEnergy = -1.;
+
+	/// Above this energy a looper survives fNumberOfTrials steps before being killed.
+	G4double fImportantEnergy = -1.;
+
+	/// Number of looping steps tolerated for important particles.
+	G4int fNumberOfTrials = -1;
+
+	/// Maximum number of chord-integration loops per step in G4PropagatorInField.
+	G4int fMaxLoopCount = -1;
+
+	/// Start time of the current track.
+	Clock::time_point fTrackStart;
+
+	/// UI messenger for the /ats/looper/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
@@ -0,0 +1,40 @@
+// ============================================================================
+//  File   : MuonAncestry.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the particle test shared by the stacking, early-abort and
+//           track-killer logic: which particles are or may lead to a muon.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef MUON_ANCESTRY_HH
+#define MUON_ANCESTRY_HH
+
+#include "globals.hh"
+
+class G4ParticleDefinition;
+
+/**
+ * @namespace MuonAncestry
+ * @brief One definition of the muon chain for every optimization that must not cut it.
+ *
+ * StackingAction tracks these particles first, EarlyAbortPolicy counts them as
+ * muon precursors and TrackKiller never kills them. Keeping the list in one
+ * place keeps the three consistent.
+ */
+namespace MuonAncestry
+{
+/**
+ * @brief Returns true for muons and for particles that may decay into one.
+ *
+ * Besides charged pions, kaons and muons, this includes every other meson but
+ * the pi0 (K0S, K0L and eta decay to charged pions) and the strange baryons
+ * (hyperons decay to a nucleon and a pion). Nucleons, which produce pions only
+ * above a threshold, are left to the callers.
+ */
+G4bool IsMuonAncestor(const G4ParticleDefinition *particle);
+} // namespace MuonAncestry
+
+#endif
@@ -0,0 +1,114 @@
+// ============================================================================
+//  File   : OffscreenRenderer.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the OffscreenRenderer class, which writes pictures of the
+//           geometry and of the top-N kept muon events through an offscreen
+//           Geant4 viewer (TSG_OFFSCREEN), for batch jobs without a display.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef OFFSCREEN_RENDERER_HH
+#define OFFSCREEN_RENDERER_HH
+
+#include "globals.hh"
+
+class G4GenericMessenger;
+class G4Run;
+
+// ============================================================================
+// OffscreenRenderer Class Declaration
+// ============================================================================
+/**
+ * @class OffscreenRenderer
+ * @brief Headless pictures of the geometry and of selected events.
+ *
+ * Works with the TSG_OFFSCREEN driver of Geant4 (>= 11.1), which renders
+ * into memory and writes image files without an X display; vis_offscreen.mac
+ * opens and configures such a viewer. Each picture is produced by pointing
+ * the driver at a file (/vis/tsg/offscreen/set/file) and rebuilding the view.
+ *
+ *  - /ats/render/geometry <file> renders the current scene (the geometry
+ *    before any run), e.g. figs/muon_target_geom.png.
+ *  - With /ats/render/events N, RunAction hands every finished run to
+ *    RenderTopEvents(); the N kept events with the most muon trajectories are
+ *    drawn once the vis manager has finished its own end-of-run redraw, one
+ *    file each: <prefix>_r<run>_e<event>.png.
+ *
+ * After each picture the driver is pointed at <prefix>_view.<format>, so later
+ * redraws of the viewer (e.g. at the end of the next run) cannot overwrite it.
+ *
+ * Lives on the master thread (the visualization runs there); in MT the events
+ * kept by the workers are merged into the master run. Without an active
+ * visualization manager nothing is rendered.
+ *
+ * Configured via the /ats/render/ UI directory.
+ */
+class OffscreenRenderer
+{
+  public:
+	/**
+	 * @brief Returns the renderer of the calling thread (created on first use).
+	 */
+	static OffscreenRenderer *Instance();
+
+	/**
+	 * @brief Destructor.
+	 */
+	~OffscreenRenderer();
+
+	/**
+	 * @brief Schedules the top-N kept events of a finished run (no-op if N is 0).
+	 *
+	 * Called from the master EndOfRunAction(); the pictures are drawn when the
+	 * run manager returns to the Idle state, after the vis manager's end of run.
+	 *
+	 * @param run Merged run holding the kept events.
+	 */
+	void RenderTopEvents(const G4Run *run);
+
+  private:
+	/// Triggers the rendering of a scheduled run at the end of the run.
+	class EndOfRunHook;
+
+	/// Private constructor: use Instance().
+	OffscreenRenderer();
+
+	/// Renders the top-N kept events of the scheduled run.
+	void RenderScheduledRun();
+
+	/// Returns true (with a warning otherwise) if a visualization manager is active.
+	G4bool IsVisActive() const;
+
+	/// Renders the current scene to a file.
+	void RenderGeometry(const G4String &fileName);
+
+	/// Points the offscreen viewer at a file and rebuilds the view.
+	void RenderToFile(const G4String &fileName);
+
+	/// Declares the /ats/render/ UI commands.
+	void DefineCommands();
+
+	/// Number of events to render at the end of each run (0: none).
+	G4int fNumEvents = 0;
+
+	/// File name prefix of the event pictures.
+	G4String fPrefix = "figs/muon_event";
+
+	/// Image format (file extension understood by the driver).
+	G4String fFormat = "png";
+
+	/// Finished run whose events are rendered at the end of the run.
+	const G4Run *fScheduledRun = nullptr;
+
+	/// State hook registered after the vis manager (created on first use).
+	EndOfRunHook *fEndOfRunHook = nullptr;
+
+	/// UI messenger for the /ats/render/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
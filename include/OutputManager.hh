@@ -0,0 +1,122 @@
+// ============================================================================
+//  File   : OutputManager.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the OutputManager class, which resolves the output file
+//           name of each run from a template (run ID, geometry, seed, job,
+//           timestamp) and writes a JSON sidecar describing the run.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef OUTPUT_MANAGER_HH
+#define OUTPUT_MANAGER_HH
+
+#include "globals.hh"
+
+#include <chrono>
+#include <map>
+#include <string>
+
+class G4GenericMessenger;
+class G4Run;
+
+// ============================================================================
+// OutputManager Class Declaration
+// ============================================================================
+/**
+ * @class OutputManager
+ * @brief Per-run output file names and JSON run records.
+ *
+ * One instance per thread (Instance()). The master resolves the template set
+ * with /ats/output/name at the beginning of each run; the workers open the
+ * same name (Geant4 appends _t<N> to per-thread files). Tokens:
+ *  - {run}: run ID, {job}: job rank (/ats/output/job),
+ *  - {geometry}: detector type, {seed}: engine seed at the start of the run,
+ *  - {timestamp}: local start time, YYYYMMDD-HHMMSS.
+ *
+ * At the end of the run the master writes <name>.json next to <name>.root:
+ * configuration (template, geometry, seed, threads, Geant4 version, git hash
+ * of the build, UI commands of the session), event counts, timing, run
+ * counters and the histogram binning, so bookkeeping and merge tools need not
+ * parse logs. Configured via the /ats/output/ UI directory.
+ */
+class OutputManager
+{
+  public:
+	/**
+	 * @brief Returns the instance of the calling thread (created on first use).
+	 */
+	static OutputManager *Instance();
+
+	/**
+	 * @brief Destructor.
+	 */
+	~OutputManager();
+
+	/**
+	 * @brief Resolves the output name of a new run (master) and returns it.
+	 * @param run The run being started.
+	 * @param master True on the master (or sequential) thread.
+	 * @return Output file name without extension.
+	 */
+	G4String BeginOfRun(const G4Run *run, G4bool master);
+
+	/**
+	 * @brief Writes the JSON sidecar of the finished run (master only).
+	 * @param run The completed (merged) run.
+	 * @param nEvents Completed events, including events resumed from a checkpoint.
+	 * @param counters Merged run counters (RunAction::SnapshotCounters).
+	 */
+	void WriteSidecar(const G4Run *run, G4long nEvents, const std::map<G4String, G4double> &counters) const;
+
+	/**
+	 * @brief Returns the output name of the current run (without extension).
+	 */
+	const G4String &GetOutputName() const { return fResolvedName; }
+
+	/**
+	 * @brief Quotes a string for JSON (also used by the LiveMonitor).
+	 *
+	 * Escapes quotes, backslashes and control characters, so UI commands,
+	 * titles and names are valid JSON whatever they contain.
+	 *
+	 * @param text Raw text.
+	 * @return The text as a JSON string literal, quotes included.
+	 */
+	static std::string Quote(const std::string &text);
+
+  private:
+	/// Private constructor: use Instance().
+	OutputManager();
+
+	/// Substitutes the tokens of the template for a run.
+	G4String Resolve(const G4Run *run) const;
+
+	/// Declares the /ats/output/ UI commands.
+	void DefineCommands();
+
+	/// Output name template.
+	G4String fTemplate = "muon_output";
+
+	/// Job rank for the {job} token (e.g. array task ID).
+	G4int fJob = 0;
+
+	/// Write the JSON sidecar at the end of each run.
+	G4bool fSidecar = true;
+
+	/// Engine seed and start times of the current run (master).
+	long fSeed = 0;
+	std::chrono::system_clock::time_point fStartClock;
+	std::chrono::steady_clock::time_point fStartTime;
+
+	/// Output name of the current run, shared with the workers.
+	static G4String fResolvedName;
+
+	/// UI messenger for the /ats/output/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
@@ -0,0 +1,163 @@
+// ============================================================================
+//  File   : PerfCounters.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the PerfCounters class, which reads hardware performance
+//           counters (cycles, instructions, cache misses, branch misses) per
+//           thread around the event loop via Linux perf_event_open.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef PERF_COUNTERS_HH
+#define PERF_COUNTERS_HH
+
+#include "globals.hh"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class G4GenericMessenger;
+
+// ============================================================================
+// PerfCounters Class Declaration
+// ============================================================================
+/**
+ * @class PerfCounters
+ * @brief Per-thread hardware counter group opened with perf_event_open.
+ *
+ * Modes (/ats/perf/mode):
+ *  - "off"   : nothing is opened (default);
+ *  - "run"   : the counters run from BeginOfRunAction to EndOfRunAction of the
+ *              thread; costs two syscalls per run;
+ *  - "event" : the counters are reset and enabled in BeginOfEventAction and read
+ *              in EndOfEventAction, so only event processing is counted; costs a
+ *              few syscalls per event.
+ *
+ * Counters are user-space only and count the calling thread, so in MT mode each
+ * worker measures itself. RunAction adds the thread totals to accumulables and
+ * prints the merged figures (IPC, misses per kilo-instruction) with the run
+ * summary. Counters the kernel refuses (VMs, perf_event_paranoid) are reported
+ * as unavailable; off Linux the class is inert.
+ */
+class PerfCounters
+{
+  public:
+	/// Hardware events read as one group.
+	enum Counter
+	{
+		kCycles,
+		kInstructions,
+		kCacheMisses,
+		kBranchMisses,
+		kNumCounters
+	};
+
+	/// Measurement mode.
+	enum Mode
+	{
+		kOff,
+		kRun,
+		kEvent
+	};
+
+	/**
+	 * @brief Returns the counters of the calling thread (created on first use).
+	 */
+	static PerfCounters *Instance();
+
+	/**
+	 * @brief Destructor. Closes any open counter.
+	 */
+	~PerfCounters();
+
+	/**
+	 * @brief Returns the current mode.
+	 */
+	Mode GetMode() const { return fMode; }
+
+	/**
+	 * @brief Opens the counter group and, in "run" mode, starts counting.
+	 */
+	void BeginOfRun();
+
+	/**
+	 * @brief Stops counting, accumulates the run totals and closes the group.
+	 */
+	void EndOfRun();
+
+	/**
+	 * @brief Resets and starts the counters ("event" mode only).
+	 */
+	void BeginOfEvent();
+
+	/**
+	 * @brief Stops the counters and adds the event counts ("event" mode only).
+	 */
+	void EndOfEvent();
+
+	/**
+	 * @brief Returns the counts of the last run of this thread.
+	 * @param counter Counter index.
+	 * @return Count, or -1 if the counter could not be opened.
+	 */
+	G4double GetCount(G4int counter) const;
+
+	/**
+	 * @brief Returns the number of events measured in "event" mode during the last run.
+	 */
+	G4int GetNumEvents() const { return fNumEvents; }
+
+	/**
+	 * @brief Returns the name of a counter.
+	 */
+	static const char *GetCounterName(G4int counter);
+
+  private:
+	/// Private constructor: use Instance().
+	PerfCounters();
+
+	/// Opens the counter group; returns false if no counter could be opened.
+	G4bool Open();
+
+	/// Closes all descriptors.
+	void Close();
+
+	/// Resets and enables the group.
+	void Start();
+
+	/// Disables the group and adds the current values to the totals.
+	void Stop();
+
+	/// Applies the /ats/perf/mode command.
+	void SetMode(const G4String &mode);
+
+	/// Declares the /ats/perf/ UI commands.
+	void DefineCommands();
+
+	/// Current mode.
+	Mode fMode = kOff;
+
+	/// File descriptor per counter (-1 if unavailable); kCycles leads the group.
+	std::array<int, kNumCounters> fFds;
+
+	/// Counters actually opened, in group read order.
+	std::vector<G4int> fOpened;
+
+	/// Totals of the current run.
+	std::array<std::uint64_t, kNumCounters> fTotals;
+
+	/// Events measured in "event" mode.
+	G4int fNumEvents = 0;
+
+	/// A warning about unavailable counters was already printed on this thread.
+	G4bool fWarned = false;
+
+	/// UI messenger for the /ats/perf/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
@@ -18,7 +18,10 @@
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "globals.hh"
 
+class BeamProfile;
+class EventSeeder;
 class G4Event;
+class G4GenericMessenger;
 
 // ============================================================================
 // PrimaryGeneratorAction Class Declaration
@@ -31,6 +34,20 @@ class G4Event;
  * muon production or muons for moderation studies—into the world volume. It defines
  * the initial conditions of the simulation, including position, momentum direction,
  * particle type, and kinetic energy. Called at the start of each event.
+ *
+ * Source modes (selected at runtime with /ats/gun/mode):
+ *  - "proton"        : 1 GeV protons, the default production-target beam
+ *                      (pencil beam, or the Twiss model of BeamProfile).
+ *  - "muon"          : monoenergetic muons.
+ *  - "pionDecayMuon" : muons from decay in flight of pions with fixed momentum.
+ *  - "surfaceMuon"   : surface-muon spectrum (pi+ decay at rest, dN/dp ~ p^3.5).
+ *
+ * Muon modes use a Gaussian spot and Gaussian angular divergence, which allows
+ * moderator and D-T stopping studies without simulating the hadronic stage.
+ *
+ * With /ats/gun/primariesPerEvent K each event carries K independent primaries,
+ * one vertex each, sampled one after the other. Vertex k becomes track ID k+1;
+ * TrackingAction tags its descendants with the primary index k.
  */
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -59,10 +76,80 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 	virtual void GeneratePrimaries(G4Event *event) override;
 
   private:
+	/**
+	 * @brief Restores the default proton beam settings on the particle gun.
+	 */
+	void ResetProtonGun();
+
+	/**
+	 * @brief Configures the particle gun from the Twiss beam model for one primary.
+	 * @param runID Run ID selecting the pre-sampled block.
+	 * @param sampleID Sample index within the run (global event ID times primaries per event, plus the primary index).
+	 */
+	void ShootProtonBeam(G4int runID, G4long sampleID);
+
+	/**
+	 * @brief Configures the particle gun for one muon according to the active muon mode.
+	 */
+	void ShootMuon();
+
+	/**
+	 * @brief Samples a beam direction around +z with Gaussian divergence.
+	 * @return Unit direction vector.
+	 */
+	G4ThreeVector SampleDirection() const;
+
+	/**
+	 * @brief Samples a vertex position with Gaussian transverse spot size.
+	 * @return Global position of the primary vertex.
+	 */
+	G4ThreeVector SamplePosition() const;
+
+	/**
+	 * @brief Declares the /ats/gun/ UI commands.
+	 */
+	void DefineCommands();
+
 	/**
 	 * @brief Pointer to the G4ParticleGun instance used to define and launch primary particles per event.
 	 */
 	G4ParticleGun *fParticleGun;
+
+	/// Pre-sampled proton beam phase-space model (/ats/beam/).
+	BeamProfile *fBeamProfile = nullptr;
+
+	/// Per-event seeding of this thread (not owned).
+	EventSeeder *fEventSeeder = nullptr;
+
+	/// UI messenger for the /ats/gun/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+
+	/// True while the gun holds sampled settings (pencil proton settings must be restored).
+	G4bool fGunResampled = false;
+
+	/// Independent primaries injected per event.
+	G4int fPrimariesPerEvent = 1;
+
+	/// Active source mode: proton | muon | pionDecayMuon | surfaceMuon.
+	G4String fMode = "proton";
+
+	/// Muon species for muon modes ("mu+" or "mu-").
+	G4String fMuonSpecies = "mu+";
+
+	/// Kinetic energy of monoenergetic muons.
+	G4double fMuonEnergy;
+
+	/// Momentum of the parent pions in pionDecayMuon mode.
+	G4double fPionMomentum;
+
+	/// Beam origin used by the muon modes.
+	G4ThreeVector fMuonPosition;
+
+	/// Gaussian transverse spot size (sigma, applied to x and y).
+	G4double fSpotSigma = 0.;
+
+	/// Gaussian angular divergence (sigma of the projected angles).
+	G4double fDivergence = 0.;
 };
 // ============================================================================
 
@@ -0,0 +1,74 @@
+// ============================================================================
+//  File   : Run.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the Run class, a G4Run that can release events it has
+//           already stored for visualization.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef RUN_HH
+#define RUN_HH
+
+#include "G4Run.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4Event;
+
+// ============================================================================
+// Run Class Declaration
+// ============================================================================
+/**
+ * @class Run
+ * @brief G4Run with early release of kept events.
+ *
+ * G4Run stores every event flagged with KeepTheCurrentEvent() until the run is
+ * deleted. ReleaseEvent() lets the KeptEventManager drop an event it no longer
+ * wants (and with it the trajectory container) soon after it is replaced.
+ *
+ * An event may still be held by the visualization (gripped for the vis
+ * sub-thread in MT, and then listed among the previous events of the run
+ * manager). Such an event is only un-kept, so the run manager deletes it once
+ * the vis manager is done. Other events are deleted one end of event later,
+ * after the run manager has dropped them from its list.
+ * Created by RunAction::GenerateRun().
+ */
+class Run : public G4Run
+{
+  public:
+	/**
+	 * @brief Constructor.
+	 */
+	Run() = default;
+
+	/**
+	 * @brief Destructor. Deletes the released events still pending.
+	 */
+	virtual ~Run();
+
+	/**
+	 * @brief Removes a stored event from the run and schedules its deletion.
+	 * @param event Event previously kept in this run; ignored if it is not stored.
+	 * @return True if the event was found and released.
+	 */
+	G4bool ReleaseEvent(const G4Event *event);
+
+	/**
+	 * @brief Deletes the events released at an earlier end of event.
+	 *
+	 * Must be called from EndOfEventAction(), before any ReleaseEvent() of
+	 * the same event.
+	 */
+	void DeleteReleasedEvents();
+
+  private:
+	/// Released events that no one grips, deleted at the next end of event.
+	std::vector<const G4Event *> fReleasedEvents;
+};
+// ============================================================================
+
+#endif
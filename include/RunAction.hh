@@ -13,9 +13,17 @@
 #ifndef RUN_ACTION_HH
 #define RUN_ACTION_HH
 
+#include "G4Accumulable.hh"
 #include "G4UserRunAction.hh"
 #include "globals.hh"
 
+#include "PerfCounters.hh"
+#include "TrackKiller.hh"
+
+#include <array>
+#include <chrono>
+#include <map>
+
 #include "TFile.h"
 #include "TH1D.h"
 
@@ -67,6 +75,12 @@ class RunAction : public G4UserRunAction
 	 */
 	virtual void EndOfRunAction(const G4Run *run) override;
 
+	/**
+	 * @brief Creates the run object (a Run, which can release kept events early).
+	 * @return Pointer to the new run, owned by the run manager.
+	 */
+	virtual G4Run *GenerateRun() override;
+
 	/**
 	 * @brief Accessor for the energy histogram.
 	 * @return Pointer to the ROOT TH1D histogram object.
@@ -79,7 +93,126 @@ class RunAction : public G4UserRunAction
 	 */
 	TH1D *GetMuonStoppingHistogram() const { return fMuonStoppingHist; }
 
+	/**
+	 * @brief Tallies a track terminated by the TrackKiller.
+	 * @param reason TrackKiller::Reason that fired.
+	 * @param kineticEnergy Kinetic energy carried away by the killed track.
+	 */
+	void RecordKilledTrack(G4int reason, G4double kineticEnergy);
+
+	/**
+	 * @brief Counts an event aborted by the early-abort policy.
+	 */
+	void RecordAbortedEvent() { fAbortedEvents += 1; }
+
+	/**
+	 * @brief Adds the primaries (protons on target) of one event.
+	 * @param nPrimaries Number of primary vertices of the event.
+	 */
+	void RecordPrimaries(G4int nPrimaries) { fNumPrimaries += nPrimaries; }
+
+	/**
+	 * @brief Adds the weighted muons created in one sub-event (sub-event parallel mode).
+	 * @param muons Weighted muons of the sub-event, scored in MuonEnergy but not in MuonsPerPrimary.
+	 */
+	void RecordSubEventMuons(G4double muons) { fSubEventMuons += muons; }
+
+	/**
+	 * @brief Returns the number of primaries of the last run (merged on the master after EndOfRunAction).
+	 */
+	G4long GetNumberOfPrimaries() const { return fNumPrimaries.GetValue(); }
+
+	/**
+	 * @brief Adds the weighted muon stops in the D-T gas of one event (figure of merit).
+	 * @param weight Sum of the weights of the muons that stopped in the D-T gas.
+	 */
+	void RecordDTStops(G4double weight)
+	{
+		fDTStopSum += weight;
+		fDTStopSum2 += weight * weight;
+	}
+
+	/**
+	 * @brief Returns the weighted D-T stops of the last run (merged on the master after EndOfRunAction).
+	 */
+	G4double GetDTStopSum() const { return fDTStopSum.GetValue(); }
+
+	/**
+	 * @brief Returns the sum over events of the squared weighted D-T stops of the last run.
+	 */
+	G4double GetDTStopSum2() const { return fDTStopSum2.GetValue(); }
+
+	/**
+	 * @brief Counts deferred tracks discarded by the StackingAction at a new stage.
+	 * @param nTracks Number of tracks dropped.
+	 */
+	void RecordDroppedTracks(G4int nTracks) { fDroppedTracks += nTracks; }
+
+	/**
+	 * @brief Adds the transport steps of one event.
+	 * @param nSteps Number of steps taken in the event.
+	 */
+	void RecordSteps(G4long nSteps) { fNumSteps += nSteps; }
+
+	/**
+	 * @brief Returns the number of steps of the last run (merged on the master after EndOfRunAction).
+	 */
+	G4long GetNumberOfSteps() const { return fNumSteps.GetValue(); }
+
+	/**
+	 * @brief Tallies a track killed by transportation as a looper.
+	 * @param kineticEnergy Kinetic energy the looper still carried.
+	 * @param seconds Wall time spent on the track before it was killed.
+	 * @param isMuon True for muons, which are reported separately.
+	 */
+	void RecordLooper(G4double kineticEnergy, G4double seconds, G4bool isMuon);
+
+	/**
+	 * @brief Adds this thread's run counters (current, unmerged values) to a checkpoint.
+	 * @param counters Named counters, filled by this method.
+	 */
+	void SnapshotCounters(std::map<G4String, G4double> &counters) const;
+
+	/**
+	 * @brief Adds the counters of a resumed checkpoint to this run.
+	 * @param counters Named counters read from the checkpoint.
+	 * @param nEvents Events processed before the checkpoint.
+	 */
+	void RestoreCounters(const std::map<G4String, G4double> &counters, G4long nEvents);
+
   private:
+	/**
+	 * @brief Prints the number of processed events and how many were aborted early.
+	 * @param run Pointer to the completed (merged) run.
+	 */
+	void PrintEventSummary(const G4Run *run) const;
+
+	/**
+	 * @brief Prints the per-run track killer tallies (count and energy per reason).
+	 */
+	void PrintKillerSummary() const;
+
+	/**
+	 * @brief Prints the per-run looper tallies (count, energy and wall time).
+	 */
+	void PrintLooperSummary() const;
+
+	/**
+	 * @brief Prints the D-T stop tally with its relative error and figure of merit.
+	 * @param run Pointer to the completed (merged) run.
+	 */
+	void PrintFigureOfMerit(const G4Run *run) const;
+
+	/**
+	 * @brief Adds this thread's hardware counts to the accumulables and prints them.
+	 */
+	void CollectPerfCounters();
+
+	/**
+	 * @brief Prints the merged hardware counts with IPC and miss rates.
+	 */
+	void PrintPerfSummary() const;
+
 	/// Pointer to the ROOT output file
 	TFile *fRootFile = nullptr;
 
@@ -88,6 +221,54 @@ class RunAction : public G4UserRunAction
 
 	/// Histogram for muon radial stopping distances (in mm)
 	TH1D *fMuonStoppingHist = nullptr;
+
+	/// Events taken over from a resumed checkpoint
+	G4Accumulable<G4int> fResumedEvents = 0;
+
+	/// Primaries of all events, i.e. protons on target (merged across threads)
+	G4Accumulable<G4long> fNumPrimaries = 0;
+
+	/// Weighted muons created in sub-events, not credited to a primary (merged across threads)
+	G4Accumulable<G4double> fSubEventMuons = 0.;
+
+	/// Per-event weighted D-T stops and their squares (merged across threads)
+	G4Accumulable<G4double> fDTStopSum = 0.;
+	G4Accumulable<G4double> fDTStopSum2 = 0.;
+
+	/// Wall-clock start of the run (master)
+	std::chrono::steady_clock::time_point fRunStart;
+
+	/// Events aborted by the early-abort policy (merged across threads)
+	G4Accumulable<G4int> fAbortedEvents = 0;
+
+	/// Deferred tracks dropped by the StackingAction (merged across threads)
+	G4Accumulable<G4int> fDroppedTracks = 0;
+
+	/// Transport steps of all events (merged across threads)
+	G4Accumulable<G4long> fNumSteps = 0;
+
+	/// Number of tracks killed per TrackKiller::Reason (merged across threads)
+	std::array<G4Accumulable<G4int>, TrackKiller::kNumReasons> fKilledTracks;
+
+	/// Kinetic energy removed per TrackKiller::Reason (merged across threads)
+	std::array<G4Accumulable<G4double>, TrackKiller::kNumReasons> fKilledEnergy;
+
+	/// Tracks killed as loopers, and how many of them were muons (merged across threads)
+	G4Accumulable<G4int> fLooperTracks = 0;
+	G4Accumulable<G4int> fLooperMuons = 0;
+
+	/// Kinetic energy and wall time of the killed loopers (merged across threads)
+	G4Accumulable<G4double> fLooperEnergy = 0.;
+	G4Accumulable<G4double> fLooperSeconds = 0.;
+
+	/// Hardware counts per PerfCounters::Counter (merged across threads)
+	std::array<G4Accumulable<G4double>, PerfCounters::kNumCounters> fPerfCounts;
+
+	/// Threads that reported each counter (merged across threads)
+	std::array<G4Accumulable<G4int>, PerfCounters::kNumCounters> fPerfThreads;
+
+	/// Events measured in per-event counter mode (merged across threads)
+	G4Accumulable<G4int> fPerfEvents = 0;
 };
 // ============================================================================
 
@@ -0,0 +1,76 @@
+// ============================================================================
+//  File   : RunInterrupt.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the RunInterrupt class, which turns SIGINT/SIGTERM into a
+//           soft abort of the current run so that the normal end-of-run merge
+//           and output still happen.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef RUN_INTERRUPT_HH
+#define RUN_INTERRUPT_HH
+
+#include "globals.hh"
+
+#include <atomic>
+#include <csignal>
+
+// ============================================================================
+// RunInterrupt Class Declaration
+// ============================================================================
+/**
+ * @class RunInterrupt
+ * @brief Graceful handling of SIGINT and SIGTERM (e.g. batch preemption).
+ *
+ * Install() registers a signal handler that only records the signal (the
+ * only async-signal-safe thing to do). EventAction calls Poll() at the start
+ * of every event; the first poll after a signal requests a soft abort of the
+ * run (G4RunManager::AbortRun(true), through the master in multithreaded
+ * mode), so in-flight events finish and EndOfRunAction merges and writes the
+ * output as usual. Later runs of the same job are aborted before their first
+ * event. RunAction reports how many of the requested events were completed.
+ *
+ * A second signal terminates the process immediately (default action).
+ */
+class RunInterrupt
+{
+  public:
+	/**
+	 * @brief Installs the SIGINT and SIGTERM handlers (POSIX only; no-op elsewhere).
+	 */
+	static void Install();
+
+	/**
+	 * @brief Requests a soft abort of the current run if a signal was received.
+	 */
+	static void Poll();
+
+	/**
+	 * @brief Allows Poll() to abort the new run (called by the master at the start of each run).
+	 */
+	static void BeginOfRun() { fAbortRequested = false; }
+
+	/**
+	 * @brief Returns the signal that interrupted the job, or 0.
+	 */
+	static G4int GetSignal() { return fSignal; }
+
+  private:
+	/// Static interface only.
+	RunInterrupt() = delete;
+
+	/// Signal handler: records the signal and writes a short notice to stderr.
+	static void Handle(int signal);
+
+	/// Signal received (0: none).
+	static volatile std::sig_atomic_t fSignal;
+
+	/// The abort of the current run has been requested.
+	static std::atomic<G4bool> fAbortRequested;
+};
+// ============================================================================
+
+#endif
@@ -0,0 +1,176 @@
+// ============================================================================
+//  File   : RunSnapshot.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the per-thread run snapshot (histograms, counters, RNG
+//           state) and the double-buffered slots through which worker threads
+//           hand it to a reader thread without waiting (checkpoints, live
+//           monitor).
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef RUN_SNAPSHOT_HH
+#define RUN_SNAPSHOT_HH
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class RunAction;
+
+// ============================================================================
+// RunSnapshot Struct Declaration
+// ============================================================================
+/**
+ * @struct RunSnapshot
+ * @brief Copy of the histograms and run counters of one thread (or a merge of several).
+ */
+struct RunSnapshot
+{
+	/// State of one histogram.
+	struct Histogram
+	{
+		std::string name;
+		std::string title;
+		G4int nBins = 0;
+		G4double xMin = 0.;
+		G4double xMax = 0.;
+		G4double entries = 0.;
+		std::vector<G4double> sumW;	 ///< per bin, underflow and overflow included
+		std::vector<G4double> sumW2; ///< per bin, underflow and overflow included (if captured)
+	};
+
+	G4int threadID = 0;
+	G4long generation = -1;
+	G4long events = 0;
+	G4long nextEvent = 0; ///< global index past the last completed event
+	std::vector<Histogram> histograms;
+	std::map<G4String, G4double> counters;
+	std::string rngState;
+
+	/**
+	 * @brief Copies the H1 histograms of this thread's analysis manager and the run counters.
+	 * @param runAction Run action of this thread (source of the counters).
+	 * @param withErrors Also copy titles and per-bin sums of squared weights.
+	 */
+	void Capture(const RunAction *runAction, G4bool withErrors);
+
+	/**
+	 * @brief Adds another snapshot (events, counters and histograms with the same binning).
+	 * @param other Snapshot of another thread.
+	 */
+	void Add(const RunSnapshot &other);
+};
+
+// ============================================================================
+// SnapshotSlot Class Declaration
+// ============================================================================
+/**
+ * @class SnapshotSlot
+ * @brief Double-buffered snapshot of one event-processing thread.
+ *
+ * The owning thread fills the back buffer without any lock, then swaps it
+ * with the front buffer under a try-lock: if a reader holds the front buffer
+ * right now, Swap() fails and the thread simply publishes again later, so it
+ * never waits for the reader.
+ */
+class SnapshotSlot
+{
+  public:
+	/**
+	 * @brief Returns the back buffer (owning thread only).
+	 */
+	RunSnapshot &Back() { return *fBack; }
+
+	/**
+	 * @brief Swaps the back buffer to the front unless a reader holds it.
+	 * @return True if the swap happened.
+	 */
+	G4bool Swap()
+	{
+		std::unique_lock<std::mutex> lock(fMutex, std::try_to_lock);
+		if (!lock.owns_lock())
+			return false;
+
+		std::swap(fFront, fBack);
+		return true;
+	}
+
+	/**
+	 * @brief Calls f with the front buffer while holding the slot lock (readers).
+	 */
+	template <typename F> void Read(F &&f) const
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+		f(static_cast<const RunSnapshot &>(*fFront));
+	}
+
+  private:
+	/// Guards the front pointer.
+	mutable std::mutex fMutex;
+	std::unique_ptr<RunSnapshot> fFront = std::make_unique<RunSnapshot>();
+	std::unique_ptr<RunSnapshot> fBack = std::make_unique<RunSnapshot>();
+};
+
+// ============================================================================
+// SnapshotSlots Class Declaration
+// ============================================================================
+/**
+ * @class SnapshotSlots
+ * @brief Registry of the slots of all event-processing threads, shared with one reader.
+ */
+class SnapshotSlots
+{
+  public:
+	/**
+	 * @brief Removes all slots (master, at the beginning of a run).
+	 */
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+		fSlots.clear();
+	}
+
+	/**
+	 * @brief Registers the slot of a processing thread.
+	 */
+	void Add(SnapshotSlot *slot)
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+		fSlots.push_back(slot);
+	}
+
+	/**
+	 * @brief Withdraws the slot of a processing thread.
+	 */
+	void Remove(SnapshotSlot *slot)
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+		fSlots.erase(std::remove(fSlots.begin(), fSlots.end(), slot), fSlots.end());
+	}
+
+	/**
+	 * @brief Calls f with the front buffer of every registered slot (readers).
+	 */
+	template <typename F> void ForEachFront(F &&f) const
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+		for (const SnapshotSlot *slot : fSlots)
+			slot->Read(f);
+	}
+
+  private:
+	/// Guards fSlots.
+	mutable std::mutex fMutex;
+	std::vector<SnapshotSlot *> fSlots;
+};
+// ============================================================================
+
+#endif
@@ -0,0 +1,194 @@
+// ============================================================================
+//  File   : SlowEventMonitor.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the SlowEventMonitor class, which times every event,
+//           keeps a running latency histogram, records events slower than a
+//           configurable percentile (RNG state, primaries, steps per species)
+//           and replays them with verbose tracking.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef SLOW_EVENT_MONITOR_HH
+#define SLOW_EVENT_MONITOR_HH
+
+#include "globals.hh"
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class G4Event;
+class G4GenericMessenger;
+class G4ParticleDefinition;
+
+// ============================================================================
+// SlowEventMonitor Class Declaration
+// ============================================================================
+/**
+ * @class SlowEventMonitor
+ * @brief Per-thread event timer with capture and replay of slow events.
+ *
+ * One instance per thread (Instance()); EventAction times the events, the
+ * master instance serves the replay command. When enabled (/ats/slow/enable):
+ *  - the run manager stores the RNG state of each event before primary
+ *    generation (G4Event::GetRandomNumberStatus());
+ *  - every event is timed and added to a log-binned latency histogram
+ *    (10 bins per decade from 1 us to 10^4 s);
+ *  - after a warm-up, events longer than the configured percentile of the
+ *    histogram are appended to <file>[_t<thread>].txt with their run/event IDs,
+ *    duration, primaries, steps per particle species and RNG state.
+ *
+ * With /ats/seed/perEvent the engine is reseeded in GeneratePrimaries(),
+ * after the run manager stored its state, so PrimaryGeneratorAction hands the
+ * reseeded state over with RecordSeededState() and that one is recorded. The
+ * event offset (/ats/seed/eventOffset) of the job is recorded as well.
+ *
+ * /ats/slow/replay <file> reads such a file and runs one event per record with
+ * /tracking/verbose 1. PrimaryGeneratorAction restores the recorded RNG state,
+ * run/event IDs and event offset (used by the Twiss beam model) before
+ * generating the primaries, so each replayed event retraces the original one
+ * exactly.
+ *
+ * Configured via the /ats/slow/ UI directory.
+ */
+class SlowEventMonitor
+{
+  public:
+	/// One recorded slow event, as read back for replay.
+	struct Record
+	{
+		G4int runID = 0;
+		G4int eventID = 0;
+		G4double seconds = 0.;
+		G4long eventOffset = -1; ///< -1: not recorded (older files), the current offset is used
+		std::string rngStatus;
+	};
+
+	/**
+	 * @brief Returns the monitor of the calling thread (created on first use).
+	 */
+	static SlowEventMonitor *Instance();
+
+	/**
+	 * @brief Destructor.
+	 */
+	~SlowEventMonitor();
+
+	/**
+	 * @brief Returns true if slow-event monitoring is enabled.
+	 */
+	G4bool IsEnabled() const { return fEnabled; }
+
+	/**
+	 * @brief Starts the event timer and clears the per-species step counts.
+	 */
+	void BeginEvent();
+
+	/**
+	 * @brief Counts one step of the given species (called by SteppingAction when enabled).
+	 */
+	void CountStep(const G4ParticleDefinition *particle) { ++fSpeciesSteps[particle]; }
+
+	/**
+	 * @brief Keeps the engine state just after per-event reseeding as the state of this event.
+	 *
+	 * Called by PrimaryGeneratorAction after EventSeeder::SeedEvent(); no-op
+	 * unless monitoring is enabled.
+	 */
+	void RecordSeededState();
+
+	/**
+	 * @brief Stops the timer, updates the histogram and records the event if it is slow.
+	 * @param event Pointer to the finished event.
+	 */
+	void EndEvent(const G4Event *event);
+
+	/**
+	 * @brief Prints this thread's latency statistics for the run and resets the run counters.
+	 */
+	void EndOfRun();
+
+	/**
+	 * @brief Returns the record to replay as event eventID of the current run, or nullptr.
+	 *
+	 * Only non-null while /ats/slow/replay is running; read-only during the run.
+	 */
+	static const Record *GetReplayRecord(G4int eventID);
+
+  private:
+	using Clock = std::chrono::steady_clock;
+
+	/// Private constructor: use Instance().
+	SlowEventMonitor();
+
+	/// Number of histogram bins (10 per decade, 1 us .. 10^4 s).
+	static constexpr G4int kNumBins = 100;
+
+	/// Returns the histogram bin of a duration.
+	static G4int GetBin(G4double seconds);
+
+	/// Returns the upper edge [s] of a histogram bin.
+	static G4double GetBinEdge(G4int bin);
+
+	/// Returns the duration below which the given percentile of events lies.
+	G4double GetPercentile(G4double percentile) const;
+
+	/// Appends one event to the record file.
+	void WriteRecord(const G4Event *event, G4double seconds);
+
+	/// Enables or disables monitoring (also the run manager's RNG status storage).
+	void SetEnabled(G4bool enabled);
+
+	/// Reads a record file and runs the recorded events with verbose tracking.
+	void Replay(const G4String &fileName);
+
+	/// Declares the /ats/slow/ UI commands.
+	void DefineCommands();
+
+	/// Enables monitoring.
+	G4bool fEnabled = false;
+
+	/// Percentile above which an event counts as slow.
+	G4double fPercentile = 99.9;
+
+	/// Events to histogram before any event can be flagged.
+	G4int fWarmupEvents = 100;
+
+	/// Base name of the record file.
+	G4String fFileName = "slow_events";
+
+	/// Running latency histogram (kept across runs).
+	std::array<G4long, kNumBins> fHistogram{};
+
+	/// Events timed and flagged in the current run, and the slowest one.
+	G4long fNumEvents = 0;
+	G4long fNumSlow = 0;
+	G4double fMaxSeconds = 0.;
+
+	/// Start time of the current event.
+	Clock::time_point fStart;
+
+	/// Engine state after per-event reseeding of the current event (empty: use the event's).
+	std::string fSeededStatus;
+
+	/// Steps per particle species in the current event.
+	std::unordered_map<const G4ParticleDefinition *, G4long> fSpeciesSteps;
+
+	/// Output stream of the record file (opened on the first slow event).
+	std::ofstream fOutput;
+
+	/// Events being replayed (shared by all threads, filled on the master).
+	static std::vector<Record> fReplayRecords;
+
+	/// UI messenger for the /ats/slow/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
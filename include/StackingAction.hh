@@ -0,0 +1,98 @@
+// ============================================================================
+//  File   : StackingAction.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the StackingAction class, which tracks muon ancestors
+//           (pions, kaons, muons and energetic nucleons) first and defers the
+//           rest of the shower, optionally dropping it at the next stage.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef STACKING_ACTION_HH
+#define STACKING_ACTION_HH
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+class G4GenericMessenger;
+class G4ParticleDefinition;
+
+// ============================================================================
+// StackingAction Class Declaration
+// ============================================================================
+/**
+ * @class StackingAction
+ * @brief Priority stacking that evaluates the shower lazily.
+ *
+ * When priority stacking is enabled, ClassifyNewTrack() sends to the urgent stack:
+ *  - primaries,
+ *  - charged pions, charged kaons and muons,
+ *  - the other mesons except the pi0 (K0S, K0L, eta) and the hyperons, which
+ *    decay to charged pions,
+ *  - nucleons above the pion-production threshold (they can still make pions).
+ * Everything else (EM shower, slow neutrons, nuclear fragments) goes to the
+ * waiting stack.
+ *
+ * NewStage() is reached once the whole pion -> muon chain has been transported.
+ * In "drop" mode the deferred tracks are then discarded (and counted). This is
+ * an approximation for muon observables: the deferred tracks can still make
+ * pions, rarely (photo-production in the EM shower, nucleons just below the
+ * threshold), and those muons are lost. In "transport" mode they are tracked
+ * as usual, so only the order changes.
+ *
+ * In sub-event parallel mode (see SubEventParallelism) the tracks that would be
+ * deferred are shipped to sub-events instead, so other threads transport the
+ * shower while this thread follows the muon chain. Inside a sub-event the usual
+ * classification applies.
+ *
+ * Configured via the /ats/stack/ UI directory.
+ */
+class StackingAction : public G4UserStackingAction
+{
+  public:
+	/**
+	 * @brief Constructor. Registers the UI commands; priority stacking starts disabled.
+	 */
+	StackingAction();
+
+	/**
+	 * @brief Destructor.
+	 */
+	virtual ~StackingAction();
+
+	/**
+	 * @brief Classifies a new track as urgent (muon ancestor) or waiting (deferred).
+	 * @param track Pointer to the new track.
+	 * @return Stack classification.
+	 */
+	virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track *track) override;
+
+	/**
+	 * @brief Called when the urgent stack is empty; drops deferred tracks in "drop" mode.
+	 */
+	virtual void NewStage() override;
+
+  private:
+	/// Returns true for tracks that may lead to a muon.
+	G4bool IsMuonAncestor(const G4Track *track) const;
+
+	/// Declares the /ats/stack/ UI commands.
+	void DefineCommands();
+
+	/// Enables urgent/waiting classification.
+	G4bool fPriority = false;
+
+	/// Discard the waiting stack at NewStage() (muon-only observables).
+	G4bool fDropDeferred = false;
+
+	/// Nucleons above this kinetic energy are treated as muon ancestors.
+	G4double fNucleonThreshold;
+
+	/// UI messenger for the /ats/stack/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
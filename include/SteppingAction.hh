@@ -19,6 +19,12 @@
 class G4LogicalVolume;
 class G4Step;
 class DetectorConstruction;
+class EventAction;
+class ImportanceSplitting;
+class LooperControl;
+class SlowEventMonitor;
+class StepProfiler;
+class TrackKiller;
 
 // ============================================================================
 // SteppingAction Class Declaration
@@ -62,6 +68,24 @@ class SteppingAction : public G4UserSteppingAction
 
 	/// Cached pointer to the logical volume designated for scoring.
 	G4LogicalVolume *fScoringVolume = nullptr;
+
+	/// Event action of this thread, looked up on the first step.
+	EventAction *fEventAction = nullptr;
+
+	/// Configurable killer for low-energy neutrons and long-lived tracks.
+	TrackKiller *fTrackKiller = nullptr;
+
+	/// Importance splitting / Russian roulette toward the D-T cell.
+	ImportanceSplitting *fImportanceSplitting = nullptr;
+
+	/// Per-thread (particle, volume) cost profiler (not owned).
+	StepProfiler *fProfiler = nullptr;
+
+	/// Per-thread slow-event monitor (not owned).
+	SlowEventMonitor *fSlowEventMonitor = nullptr;
+
+	/// Per-thread looper thresholds and detection (not owned).
+	LooperControl *fLooperControl = nullptr;
 };
 // ============================================================================
 
@@ -0,0 +1,106 @@
+// ============================================================================
+//  File   : SubEventParallelism.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the SubEventParallelism class, which sets up Geant4's
+//           sub-event parallel mode so the hadronic shower of one heavy event
+//           is split across worker threads.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef SUB_EVENT_PARALLELISM_HH
+#define SUB_EVENT_PARALLELISM_HH
+
+#include "G4ClassificationOfNewTrack.hh"
+#include "globals.hh"
+
+class G4Event;
+class G4RunManager;
+
+// ============================================================================
+// SubEventParallelism Class Declaration
+// ============================================================================
+/**
+ * @class SubEventParallelism
+ * @brief Sub-event parallel mode (Geant4 11.2 or later, multithreaded builds).
+ *
+ * With event-level MT, a 1 GeV proton shower in tungsten keeps one thread busy
+ * for the whole event. In sub-event mode the event itself is tracked on one
+ * thread, but StackingAction classifies every new track that cannot lead to a
+ * muon (see StackingAction::IsMuonAncestor()) as a sub-event track. Geant4
+ * bundles these tracks into sub-events of a fixed size and hands them to idle
+ * worker threads as tasks.
+ *
+ * Scoring stays consistent because:
+ *  - histograms and RunAction accumulables are per thread and merged at the
+ *    end of the run, so they do not care which thread tracked a step;
+ *  - the muon chain is never shipped, so per-event state (kept events,
+ *    MuonsPerPrimary, muon stops in D-T) stays on the thread of its event;
+ *    a shipped gamma or neutron can still make a pion and so a muon inside a
+ *    sub-event: it is scored in the muon histograms, but as it has no primary
+ *    it is counted apart (run summary) instead of in MuonsPerPrimary, and
+ *    the sub-event is not kept for display;
+ *  - sub-events carry no primary vertices, so they add no primaries to the
+ *    normalization and are excluded from event keeping and the event display.
+ *
+ * The early-abort policy is disabled in this mode: the shower of an event may
+ * still be in flight on other threads when the event could be aborted.
+ *
+ * The run manager type is fixed at construction, so the mode is selected on the
+ * command line (--subevent), not with a UI command.
+ */
+class SubEventParallelism
+{
+  public:
+	/**
+	 * @brief Returns true if this build supports sub-event parallelism.
+	 */
+	static G4bool IsAvailable();
+
+	/**
+	 * @brief Creates a sub-event parallel run manager and registers the shower sub-event type.
+	 * @param nThreads Worker threads (0 or less: all cores).
+	 * @param tracksPerSubEvent Tracks bundled into one sub-event.
+	 * @return The run manager, or nullptr if this build does not support the mode.
+	 */
+	static G4RunManager *CreateRunManager(G4int nThreads, G4int tracksPerSubEvent);
+
+	/**
+	 * @brief Returns true once a sub-event parallel run manager has been created.
+	 */
+	static G4bool IsActive() { return fActive; }
+
+	/**
+	 * @brief Returns true if the event is a sub-event (it has no primary vertices).
+	 * @param event Event currently processed by this thread.
+	 */
+	static G4bool IsSubEvent(const G4Event *event);
+
+	/**
+	 * @brief Classification that ships a new track to a sub-event (fUrgent if unavailable).
+	 */
+	static G4ClassificationOfNewTrack GetShowerClassification();
+
+	/**
+	 * @brief Returns the number of tracks bundled into one sub-event.
+	 */
+	static G4int GetTracksPerSubEvent() { return fTracksPerSubEvent; }
+
+  private:
+	/// Static interface only.
+	SubEventParallelism() = delete;
+
+	/// Sub-event type used for the shower tracks.
+	static constexpr G4int kShowerType = 0;
+
+	/// A sub-event parallel run manager exists (set once, before any worker starts).
+	static G4bool fActive;
+
+	/// Tracks per sub-event.
+	static G4int fTracksPerSubEvent;
+};
+// ============================================================================
+
+#endif
@@ -0,0 +1,138 @@
+// ============================================================================
+//  File   : ThreadAffinity.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the ThreadAffinity class, which pins every worker thread
+//           to a CPU (compact, scatter or explicit list) before the worker
+//           builds its geometry, physics and user actions.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef THREAD_AFFINITY_HH
+#define THREAD_AFFINITY_HH
+
+#include "G4Threading.hh"
+#include "G4UserWorkerThreadInitialization.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4GenericMessenger;
+
+// ============================================================================
+// ThreadAffinity Class Declaration
+// ============================================================================
+/**
+ * @class ThreadAffinity
+ * @brief Optional NUMA-aware pinning of the worker threads (Linux only).
+ *
+ * SetupRNGEngine() is the first user hook that runs on a new worker thread.
+ * The worker pins itself there and only then builds its geometry and physics
+ * caches, its run manager and its user actions (RunAction, scorers, ...). The
+ * kernel places memory on the node of the thread that first touches it, so all
+ * of these thread-local allocations land on the worker's own socket.
+ *
+ * Placement policies (/ats/affinity/policy):
+ *  - "none"    : no pinning, the scheduler may migrate threads (default).
+ *  - "compact" : fill one socket before the next; one thread per physical
+ *                core first, then the SMT siblings of that socket.
+ *  - "scatter" : alternate sockets (thread k on socket k mod S), each socket
+ *                filled in compact order, to spread memory bandwidth.
+ *  - "list"    : thread k on the k-th CPU of /ats/affinity/cpus (e.g. "0-7,16-23").
+ * Threads beyond the number of CPUs wrap around. Only CPUs in the process
+ * affinity mask (taskset, cgroups, batch scheduler) are used.
+ *
+ * The commands only act on workers started afterwards, so they must be issued
+ * before /run/initialize; a change after that is kept for workers started
+ * later and reported with a warning. The class replaces the default
+ * worker-thread initialization of G4MTRunManager; task-based run managers
+ * (including the sub-event parallel one) create their own workers and are not
+ * supported. In serial and sub-event runs main() still creates an instance
+ * without installing it, so macros with /ats/affinity/ commands run in every
+ * mode (the commands are then ignored with a warning).
+ */
+class ThreadAffinity : public G4UserWorkerThreadInitialization
+{
+  public:
+	/**
+	 * @brief Constructor. Registers the UI commands; pinning starts disabled.
+	 * @param pinWorkers False if the instance is not installed in the run manager
+	 *                   (no worker threads to pin; the commands only warn).
+	 */
+	explicit ThreadAffinity(G4bool pinWorkers = true);
+
+	/**
+	 * @brief Destructor.
+	 */
+	virtual ~ThreadAffinity();
+
+	/**
+	 * @brief Pins the calling worker thread, then sets up its random engine.
+	 * @param masterEngine Random engine of the master (cloned by the base class).
+	 */
+	virtual void SetupRNGEngine(const CLHEP::HepRandomEngine *masterEngine) const override;
+
+  private:
+	/// One logical CPU with its position in the machine.
+	struct Cpu
+	{
+		G4int id = 0;
+		G4int socket = 0;
+		G4int core = 0;
+		G4int sibling = 0; ///< rank among the SMT siblings of its core
+	};
+
+	/// Returns the CPUs of the process affinity mask with their socket and core (sysfs).
+	static std::vector<Cpu> ReadTopology();
+
+	/// Parses a CPU list such as "0-3,8,10-11".
+	static std::vector<G4int> ParseCpuList(const G4String &list);
+
+	/// Builds the CPU order of the active policy (master data; the caller holds fMutex).
+	void BuildOrder() const;
+
+	/// Returns the CPU of a worker thread in the current order; false if it is not pinned.
+	G4bool GetCpu(G4int thread, Cpu &cpu) const;
+
+	/// Sets the placement policy (UI command).
+	void SetPolicy(const G4String &policy);
+
+	/// Sets the CPU list of the "list" policy (UI command).
+	void SetCpuList(const G4String &list);
+
+	/// Discards the CPU order after a change and warns if it cannot take effect.
+	void PlacementChanged();
+
+	/// Pins the calling thread to one CPU; returns false if the system refused.
+	static G4bool Pin(G4int cpu);
+
+	/// Declares the /ats/affinity/ UI commands.
+	void DefineCommands();
+
+	/// Placement policy: none | compact | scatter | list.
+	G4String fPolicy = "none";
+
+	/// CPU list of the "list" policy.
+	G4String fCpuList;
+
+	/// Installed as the worker initialization of the run manager.
+	G4bool fPinWorkers;
+
+	/// CPU of thread k is fOrder[k % size], with the socket of each entry.
+	mutable std::vector<Cpu> fOrder;
+	mutable G4bool fOrderBuilt = false;
+
+	/// At least one worker has started (and been placed, unless the policy was "none").
+	mutable G4bool fWorkersStarted = false;
+
+	/// Guards fOrder and the flags (built lazily by the first worker).
+	mutable G4Mutex fMutex;
+
+	/// UI messenger for the /ats/affinity/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
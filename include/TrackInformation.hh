@@ -0,0 +1,113 @@
+// ============================================================================
+//  File   : TrackInformation.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the TrackInformation class, the user information attached
+//           to tracks for bookkeeping that Geant4 does not provide natively
+//           (e.g. tracks cloned by importance splitting).
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef TRACK_INFORMATION_HH
+#define TRACK_INFORMATION_HH
+
+#include "G4VUserTrackInformation.hh"
+#include "globals.hh"
+
+// ============================================================================
+// TrackInformation Class Declaration
+// ============================================================================
+/**
+ * @class TrackInformation
+ * @brief User track information carried by tracks that need extra bookkeeping.
+ *
+ * Attached with G4Track::SetUserInformation(); the track owns and deletes it.
+ */
+class TrackInformation : public G4VUserTrackInformation
+{
+  public:
+	/**
+	 * @brief Constructor.
+	 */
+	TrackInformation() = default;
+
+	/**
+	 * @brief Copy constructor, used to hand the information on to clones.
+	 */
+	TrackInformation(const TrackInformation &other) = default;
+
+	/**
+	 * @brief Destructor.
+	 */
+	virtual ~TrackInformation() = default;
+
+	/**
+	 * @brief Marks the track as a copy created by importance splitting.
+	 *
+	 * A split clone starts at a cell boundary, not at a physics vertex, so its
+	 * first step must not be scored as a particle creation.
+	 */
+	void SetSplitClone(G4bool clone) { fSplitClone = clone; }
+
+	/**
+	 * @brief Returns true if the track was created by importance splitting.
+	 */
+	G4bool IsSplitClone() const { return fSplitClone; }
+
+	/**
+	 * @brief Marks the track as killed by Russian roulette.
+	 *
+	 * Such a track did not stop physically, so its end must not be scored as a stop.
+	 */
+	void SetRouletteKilled(G4bool killed) { fRouletteKilled = killed; }
+
+	/**
+	 * @brief Returns true if the track was killed by Russian roulette.
+	 */
+	G4bool IsRouletteKilled() const { return fRouletteKilled; }
+
+	/**
+	 * @brief Marks the track as killed by transportation as a looper.
+	 *
+	 * Such a track still had kinetic energy, so its end must not be scored as a stop.
+	 */
+	void SetLooperKilled(G4bool killed) { fLooperKilled = killed; }
+
+	/**
+	 * @brief Returns true if the track was killed as a looper.
+	 */
+	G4bool IsLooperKilled() const { return fLooperKilled; }
+
+	/**
+	 * @brief Marks the track as an electron or positron from muon decay.
+	 */
+	void SetMuonDecayProduct(G4bool product) { fMuonDecayProduct = product; }
+
+	/**
+	 * @brief Returns true if the track is an electron or positron from muon decay.
+	 */
+	G4bool IsMuonDecayProduct() const { return fMuonDecayProduct; }
+
+	/**
+	 * @brief Prints the stored information.
+	 */
+	virtual void Print() const override;
+
+  private:
+	/// Track is a split copy of another track.
+	G4bool fSplitClone = false;
+
+	/// Track was killed by Russian roulette.
+	G4bool fRouletteKilled = false;
+
+	/// Track was killed as a looper in a magnetic field.
+	G4bool fLooperKilled = false;
+
+	/// Track is an e+/e- from muon decay.
+	G4bool fMuonDecayProduct = false;
+};
+// ============================================================================
+
+#endif
@@ -0,0 +1,118 @@
+// ============================================================================
+//  File   : TrackKiller.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the TrackKiller class, a configurable step-level filter
+//           that terminates low-energy neutrons, long-lived tracks, and tracks
+//           escaping the apparatus, which cost CPU but never influence muon
+//           observables.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef TRACK_KILLER_HH
+#define TRACK_KILLER_HH
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class DetectorConstruction;
+class G4Box;
+class G4GenericMessenger;
+class G4ParticleDefinition;
+class G4Step;
+
+// ============================================================================
+// TrackKiller Class Declaration
+// ============================================================================
+/**
+ * @class TrackKiller
+ * @brief Terminates tracks that are irrelevant for muon production and stopping.
+ *
+ * Three independent rules are applied to every step (when enabled):
+ *  - Neutrons whose kinetic energy drops below a threshold.
+ *  - Any track whose global time exceeds a threshold.
+ *  - Tracks in the world air, outside the apparatus envelope, that can no longer
+ *    re-enter it along a straight line (world-exit policy).
+ *
+ * Charged pions, kaons and muons (the muon chain) are never killed. Every kill is
+ * tallied with its kinetic energy in RunAction so the per-run summary can show
+ * that the discarded tracks carry a negligible share of the physics.
+ *
+ * Configured via the /ats/killer/ UI directory.
+ */
+class TrackKiller
+{
+  public:
+	/// Reason a track was terminated; used to index the per-run tallies.
+	enum Reason
+	{
+		kNeutronEnergy = 0,
+		kGlobalTime,
+		kWorldExit,
+		kNumReasons
+	};
+
+	/**
+	 * @brief Constructor.
+	 * @param detectorConstruction Pointer to the geometry, used for the apparatus envelope.
+	 */
+	TrackKiller(const DetectorConstruction *detectorConstruction);
+
+	/**
+	 * @brief Destructor.
+	 */
+	~TrackKiller();
+
+	/**
+	 * @brief Applies the kill rules to the current step.
+	 * @param step Pointer to the current G4Step.
+	 * @return True if the track was killed in this step.
+	 */
+	G4bool Apply(const G4Step *step);
+
+	/**
+	 * @brief Human-readable label for a kill reason.
+	 * @param reason One of the Reason values.
+	 * @return Short label used in the run summary.
+	 */
+	static const char *GetReasonName(G4int reason);
+
+  private:
+	/// Returns true for muons and the particles that may decay into one (never killed).
+	G4bool IsMuonChain(const G4ParticleDefinition *particle) const;
+
+	/// Returns true if a straight line from pos along dir never enters the envelope.
+	G4bool IsLeavingEnvelope(const G4ThreeVector &pos, const G4ThreeVector &dir);
+
+	/// Declares the /ats/killer/ UI commands.
+	void DefineCommands();
+
+	/// Pointer to detector construction class to access the apparatus envelope.
+	const DetectorConstruction *fDetectorConstruction;
+
+	/// Envelope solid built lazily on first use (geometry exists only after /run/initialize).
+	G4Box *fEnvelope = nullptr;
+
+	/// Center of the envelope in global coordinates.
+	G4ThreeVector fEnvelopeCenter;
+
+	/// Master switch for all rules.
+	G4bool fEnabled = false;
+
+	/// Neutrons below this kinetic energy are killed (0 disables the rule).
+	G4double fNeutronEnergyThreshold;
+
+	/// Tracks older than this global time are killed (0 disables the rule).
+	G4double fGlobalTimeThreshold;
+
+	/// World-exit policy: "off", "neutral" (neutral tracks only), or "all".
+	G4String fWorldExitPolicy = "neutral";
+
+	/// UI messenger for the /ats/killer/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
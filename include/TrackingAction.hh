@@ -27,8 +27,15 @@
  * it is used to print and log muon creation information — including energy,
  * position, and process — and to record final muon stopping coordinates (Z, radial).
  * Histogram entries are filled for subsequent ROOT analysis.
+ * Every new track is also registered with the EventAction, which maps it to
+ * the primary it descends from in events with several primaries.
  */
 class G4Track;
+class EventAction;
+class EventDisplayWriter;
+class LooperControl;
+class StepProfiler;
+class TrajectoryFilter;
 
 class TrackingAction : public G4UserTrackingAction
 {
@@ -57,6 +64,22 @@ class TrackingAction : public G4UserTrackingAction
 	 * @param track Pointer to the GEANT4 track that just completed.
 	 */
 	virtual void PostUserTrackingAction(const G4Track *track) override;
+
+  private:
+	/// Per-thread (particle, volume) cost profiler (not owned).
+	StepProfiler *fProfiler = nullptr;
+
+	/// Per-thread looper control, stamped at each track start (not owned).
+	LooperControl *fLooperControl = nullptr;
+
+	/// Per-track choice of stored trajectories.
+	TrajectoryFilter *fTrajectoryFilter = nullptr;
+
+	/// Per-thread event-display writer, told the creator of each track (not owned).
+	EventDisplayWriter *fEventDisplayWriter = nullptr;
+
+	/// Event action of this thread, told the parent of each track (not owned).
+	EventAction *fEventAction = nullptr;
 };
 // ============================================================================
 
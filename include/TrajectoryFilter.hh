@@ -0,0 +1,102 @@
+// ============================================================================
+//  File   : TrajectoryFilter.hh
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Declares the TrajectoryFilter class, which decides per track
+//           whether a trajectory is stored, restricting trajectory storage to
+//           the muon production chain.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#ifndef TRAJECTORY_FILTER_HH
+#define TRAJECTORY_FILTER_HH
+
+#include "G4TrackVector.hh"
+#include "globals.hh"
+
+class G4GenericMessenger;
+class G4ParticleDefinition;
+class G4Track;
+
+// ============================================================================
+// TrajectoryFilter Class Declaration
+// ============================================================================
+/**
+ * @class TrajectoryFilter
+ * @brief Stores trajectories only for muon-chain particles.
+ *
+ * With /tracking/storeTrajectory (or the visualization) on, Geant4 builds a
+ * trajectory for every track, and the electromagnetic shower dominates memory
+ * and time. When enabled, TrackingAction asks Select() before each track and
+ * switches the tracking manager's storage off for tracks that are not:
+ *  - protons, charged pions, charged kaons or muons, or
+ *  - electrons and positrons from muon decay (tagged by TagDecayProducts()),
+ * and above the kinetic-energy floor. The storage mode chosen by the user
+ * (plain, smooth, rich) is restored for selected tracks, and returned
+ * unchanged for every track while the filter is disabled.
+ *
+ * Configured via the /ats/traj/ UI directory.
+ */
+class TrajectoryFilter
+{
+  public:
+	/**
+	 * @brief Constructor. Registers the UI commands; the filter starts disabled.
+	 */
+	TrajectoryFilter();
+
+	/**
+	 * @brief Destructor.
+	 */
+	~TrajectoryFilter();
+
+	/**
+	 * @brief Returns true if the filter is enabled.
+	 */
+	G4bool IsEnabled() const { return fEnabled; }
+
+	/**
+	 * @brief Returns the trajectory storage mode for a new track.
+	 * @param track Track about to be processed.
+	 * @param currentMode Storage mode currently set in the tracking manager.
+	 * @return Mode to set: the user's mode for selected tracks (or when disabled), 0 otherwise.
+	 */
+	G4int Select(const G4Track *track, G4int currentMode);
+
+	/**
+	 * @brief Tags the e+/e- produced by the decay of a finished muon.
+	 * @param track Muon track that just ended.
+	 * @param secondaries Secondaries produced by the track.
+	 */
+	void TagDecayProducts(const G4Track *track, const G4TrackVector *secondaries) const;
+
+  private:
+	/// Returns true for protons, charged pions, charged kaons and muons.
+	G4bool IsChainParticle(const G4ParticleDefinition *particle) const;
+
+	/// Declares the /ats/traj/ UI commands.
+	void DefineCommands();
+
+	/// Opt-in switch.
+	G4bool fEnabled = false;
+
+	/// Also store muon decay electrons and positrons.
+	G4bool fDecayElectrons = true;
+
+	/// Tracks below this kinetic energy get no trajectory.
+	G4double fMinEnergy = 0.;
+
+	/// Storage mode requested by the user (restored for selected tracks).
+	G4int fUserMode = 0;
+
+	/// The previous track had its storage switched off by this filter.
+	G4bool fSuppressed = false;
+
+	/// UI messenger for the /ats/traj/ commands.
+	G4GenericMessenger *fMessenger = nullptr;
+};
+// ============================================================================
+
+#endif
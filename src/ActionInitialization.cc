@@ -0,0 +1,71 @@
+// ============================================================================
+//  File   : ActionInitialization.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Instantiates the user actions for the master and worker threads.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "ActionInitialization.hh"
+#include "DetectorConstruction.hh"
+#include "EventAction.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
+#include "StackingAction.hh"
+#include "SteppingAction.hh"
+#include "TrackingAction.hh"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+/**
+ * @brief Constructor
+ */
+ActionInitialization::ActionInitialization(const DetectorConstruction *detectorConstruction)
+	: fDetectorConstruction(detectorConstruction)
+{
+}
+
+// ============================================================================
+// Build Methods
+// ============================================================================
+
+/**
+ * @brief Creates the master run action (merging and run summaries only).
+ */
+void ActionInitialization::BuildForMaster() const
+{
+	SetUserAction(new RunAction());
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Creates the user actions of one thread.
+ *
+ * The order matters: actions that look up other actions (SteppingAction finds
+ * the EventAction, TrackingAction and StackingAction find the RunAction) only do
+ * so lazily, during the run.
+ */
+void ActionInitialization::Build() const
+{
+	SetUserAction(new EventAction());
+
+	// Primary generator (defines the particle beam)
+	SetUserAction(new PrimaryGeneratorAction());
+
+	// Actions at the start and end of each simulation run
+	SetUserAction(new RunAction());
+
+	// Step-level user actions (e.g., scoring)
+	SetUserAction(new SteppingAction(fDetectorConstruction));
+
+	// Register user-defined tracking action (e.g., muon birth info)
+	SetUserAction(new TrackingAction());
+
+	// Stack ordering: muon ancestors first, rest of the shower deferred (opt-in)
+	SetUserAction(new StackingAction());
+}
+// ============================================================================
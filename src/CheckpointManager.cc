@@ -0,0 +1,536 @@
+// ============================================================================
+//  File   : CheckpointManager.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements periodic checkpoints (double-buffered per-thread
+//           snapshots merged by a writer thread into an atomically renamed
+//           ROOT file) and the resume from a checkpoint.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "CheckpointManager.hh"
+#include "EventSeeder.hh"
+#include "RunAction.hh"
+
+#include "G4AnalysisManager.hh"
+#include "G4AutoDelete.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Threading.hh"
+#include "G4UImanager.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+
+#include "TFile.h"
+#include "TH1D.h"
+#include "TKey.h"
+#include "TObjString.h"
+#include "TParameter.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+SnapshotSlots CheckpointManager::fSlots;
+std::unique_ptr<RunSnapshot> CheckpointManager::fBase;
+G4bool CheckpointManager::fBaseSeparate = false;
+std::mutex CheckpointManager::fMutex;
+std::condition_variable CheckpointManager::fWake;
+std::atomic<G4long> CheckpointManager::fEventsDone{0};
+std::atomic<G4long> CheckpointManager::fRequested{0};
+std::atomic<G4bool> CheckpointManager::fStop{false};
+G4String CheckpointManager::fOutputName;
+G4double CheckpointManager::fPeriod = 0.;
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the instance of the calling thread, deleted at thread exit.
+ */
+CheckpointManager *CheckpointManager::Instance()
+{
+	static G4ThreadLocal CheckpointManager *instance = nullptr;
+	if (!instance)
+	{
+		instance = new CheckpointManager();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ */
+CheckpointManager::CheckpointManager()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+CheckpointManager::~CheckpointManager()
+{
+	if (fWriter.joinable())
+	{
+		fStop = true;
+		fWake.notify_all();
+		fWriter.join();
+	}
+	delete fMessenger;
+}
+
+// ============================================================================
+// Run Lifecycle
+// ============================================================================
+
+/**
+ * @brief Applies a pending resume and starts checkpointing for the run.
+ *
+ * The master (which begins the run before the workers) resets the shared state,
+ * including the resumed base of the previous run, and starts the writer
+ * thread; every event-processing thread then registers its snapshot slot.
+ *
+ * @param runAction Run action of the calling thread.
+ * @param master True on the master (or sequential) thread.
+ * @param processing True on threads that process events.
+ */
+void CheckpointManager::BeginOfRun(RunAction *runAction, G4bool master, G4bool processing)
+{
+	if (master)
+	{
+		fBase.reset();
+		if (fResume)
+		{
+			ApplyResume(runAction);
+		}
+	}
+
+	if (!IsEnabled())
+		return;
+
+	if (master)
+	{
+		fSlots.Clear();
+		fEventsDone = 0;
+		fRequested = 0;
+		fStop = false;
+		fOutputName = fFileName;
+		fPeriod = fEverySeconds;
+
+		ROOT::EnableThreadSafety();
+		fWriter = std::thread(&CheckpointManager::WriterLoop, this);
+	}
+
+	if (processing)
+	{
+		fSlot = std::make_unique<SnapshotSlot>();
+		fPublished = 0;
+		fNumEvents = 0;
+		fNextEvent = 0;
+		fSlots.Add(fSlot.get());
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Counts a finished event and publishes a snapshot if one is requested.
+ *
+ * The thread that completes a multiple of N events (over all threads)
+ * requests the next checkpoint.
+ *
+ * @param runAction Run action of the calling thread.
+ * @param eventID ID of the finished event within the run.
+ */
+void CheckpointManager::EndOfEvent(const RunAction *runAction, G4int eventID)
+{
+	if (!fSlot)
+		return;
+
+	++fNumEvents;
+	fNextEvent = std::max(fNextEvent, EventSeeder::Instance()->GetEventOffset() + eventID + 1);
+	G4long done = ++fEventsDone;
+	if (fEveryEvents > 0 && done % fEveryEvents == 0)
+	{
+		++fRequested;
+		fWake.notify_one();
+	}
+
+	G4long requested = fRequested;
+	if (requested > fPublished)
+	{
+		Publish(runAction, requested);
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Stops checkpointing for the run.
+ *
+ * Processing threads withdraw their slot; the master, whose end of run comes
+ * after all workers, stops and joins the writer thread. The final result is
+ * written by RunAction as usual; the last checkpoint stays on disk.
+ *
+ * @param master True on the master (or sequential) thread.
+ */
+void CheckpointManager::EndOfRun(G4bool master)
+{
+	if (fSlot)
+	{
+		fSlots.Remove(fSlot.get());
+	}
+
+	if (master && fWriter.joinable())
+	{
+		fStop = true;
+		fWake.notify_all();
+		fWriter.join();
+	}
+
+	fSlot.reset();
+}
+
+// ============================================================================
+// Snapshots
+// ============================================================================
+
+/**
+ * @brief Fills the back buffer of this thread and swaps it to the front.
+ *
+ * If the writer is reading the front buffer right now, the snapshot is
+ * published again at the end of the next event instead of waiting.
+ *
+ * @param runAction Run action of this thread (source of the counters).
+ * @param generation Checkpoint generation being answered.
+ */
+void CheckpointManager::Publish(const RunAction *runAction, G4long generation)
+{
+	RunSnapshot &snapshot = fSlot->Back();
+	snapshot.Capture(runAction, true);
+	snapshot.threadID = G4Threading::G4GetThreadId();
+	snapshot.generation = generation;
+	snapshot.events = fNumEvents;
+	snapshot.nextEvent = fNextEvent;
+
+	std::ostringstream rng;
+	G4Random::saveFullState(rng);
+	snapshot.rngState = rng.str();
+
+	if (fSlot->Swap())
+		fPublished = generation;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Writer thread: waits for a request (or the timer) and writes the checkpoint.
+ *
+ * After a request, threads get up to 5 s to publish at the end of their next
+ * event; threads that did not (e.g. stuck in a long event) contribute their
+ * previous snapshot.
+ */
+void CheckpointManager::WriterLoop()
+{
+	using Clock = std::chrono::steady_clock;
+
+	G4long written = 0;
+	auto lastWrite = Clock::now();
+
+	std::unique_lock<std::mutex> lock(fMutex);
+	while (!fStop)
+	{
+		fWake.wait_for(lock, std::chrono::seconds(1));
+		if (fStop)
+			break;
+
+		if (fPeriod > 0. && std::chrono::duration<G4double>(Clock::now() - lastWrite).count() >= fPeriod)
+		{
+			++fRequested;
+		}
+
+		G4long generation = fRequested;
+		if (generation <= written)
+			continue;
+
+		lock.unlock();
+		auto deadline = Clock::now() + std::chrono::seconds(5);
+		while (!fStop && Clock::now() < deadline)
+		{
+			G4bool complete = true;
+			fSlots.ForEachFront([&](const RunSnapshot &front) {
+				complete = complete && front.generation >= generation;
+			});
+			if (complete)
+				break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		}
+
+		Write(generation);
+		written = generation;
+		lastWrite = Clock::now();
+		lock.lock();
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Merges the front buffers of all threads and writes the checkpoint.
+ *
+ * The file is written as <file>.tmp.root and renamed to <file>.root, so a
+ * crash during the write leaves the previous checkpoint intact. Histograms
+ * are stored as TH1D (underflow/overflow included), counters as
+ * TParameter<double> ("events", "next_event", "counter_<name>") and the RNG state of each
+ * thread as TObjString ("rng_t<thread>").
+ *
+ * The resumed base is added as well. In MT it lives on the master, which has
+ * no slot, so it is merged in full; in sequential mode the thread's snapshot
+ * already contains its histograms and counters, so only its events count.
+ *
+ * Runs on the writer thread, so messages go to std::cout rather than G4cout.
+ *
+ * @param generation Checkpoint generation.
+ */
+void CheckpointManager::Write(G4long generation)
+{
+	std::vector<RunSnapshot> snapshots;
+	fSlots.ForEachFront([&](const RunSnapshot &front) {
+		if (front.generation > 0)
+			snapshots.push_back(front);
+	});
+	if (snapshots.empty())
+		return;
+
+	// Merge
+	RunSnapshot merged = snapshots.front();
+	for (size_t s = 1; s < snapshots.size(); ++s)
+		merged.Add(snapshots[s]);
+
+	// Events (and in MT the content) of the resumed checkpoint
+	if (fBase && fBaseSeparate)
+	{
+		merged.Add(*fBase);
+	}
+	else if (fBase)
+	{
+		merged.events += fBase->events;
+		merged.nextEvent = std::max(merged.nextEvent, fBase->nextEvent);
+	}
+
+	// Write and atomically replace
+	std::string finalName = fOutputName + ".root";
+	std::string tmpName = fOutputName + ".tmp.root";
+	{
+		TFile file(tmpName.c_str(), "RECREATE");
+		if (file.IsZombie())
+		{
+			std::cerr << "[Checkpoint] Cannot write " << tmpName << std::endl;
+			return;
+		}
+
+		for (const RunSnapshot::Histogram &h : merged.histograms)
+		{
+			if (h.nBins <= 0)
+				continue;
+
+			TH1D hist(h.name.c_str(), h.title.c_str(), h.nBins, h.xMin, h.xMax);
+			hist.Sumw2();
+			for (G4int b = 0; b <= h.nBins + 1 && b < static_cast<G4int>(h.sumW.size()); ++b)
+			{
+				hist.SetBinContent(b, h.sumW[b]);
+				hist.SetBinError(b, std::sqrt(h.sumW2[b]));
+			}
+			hist.SetEntries(h.entries);
+			hist.Write();
+		}
+
+		TParameter<double>("events", merged.events).Write();
+		TParameter<double>("next_event", merged.nextEvent).Write();
+		TParameter<double>("generation", generation).Write();
+		for (const auto &[name, value] : merged.counters)
+			TParameter<double>(("counter_" + name).c_str(), value).Write();
+		for (const RunSnapshot &snapshot : snapshots)
+			TObjString(snapshot.rngState.c_str()).Write(("rng_t" + std::to_string(snapshot.threadID)).c_str());
+
+		file.Close();
+	}
+
+	if (std::rename(tmpName.c_str(), finalName.c_str()) != 0)
+	{
+		std::cerr << "[Checkpoint] Cannot rename " << tmpName << " to " << finalName << std::endl;
+		return;
+	}
+
+	std::cout << "[Checkpoint] " << finalName << " | Events: " << merged.events
+			  << " | Threads: " << snapshots.size() << std::endl;
+}
+
+// ============================================================================
+// Resume
+// ============================================================================
+
+/**
+ * @brief Reads a checkpoint file and restores the random engine and event offset.
+ *
+ * Executed on the master only. Histograms and counters are kept until the
+ * next run begins (its histograms do not exist yet). The event offset is set
+ * with a UI command, so the workers of the next run receive it as well.
+ * Checkpoints without "next_event" (older files) fall back to the event count.
+ *
+ * @param fileName Checkpoint written by a previous job.
+ */
+void CheckpointManager::Resume(const G4String &fileName)
+{
+	TFile file(fileName.c_str(), "READ");
+	if (file.IsZombie())
+	{
+		G4Exception("CheckpointManager::Resume()", "FileNotFound", JustWarning,
+					("Cannot open checkpoint " + fileName).c_str());
+		return;
+	}
+
+	auto snapshot = std::make_unique<RunSnapshot>();
+	TIter next(file.GetListOfKeys());
+	while (auto key = static_cast<TKey *>(next()))
+	{
+		TObject *object = key->ReadObj();
+		if (auto hist = dynamic_cast<TH1D *>(object))
+		{
+			RunSnapshot::Histogram h;
+			h.name = hist->GetName();
+			h.title = hist->GetTitle();
+			h.nBins = hist->GetNbinsX();
+			h.xMin = hist->GetXaxis()->GetXmin();
+			h.xMax = hist->GetXaxis()->GetXmax();
+			h.entries = hist->GetEntries();
+			for (G4int b = 0; b <= h.nBins + 1; ++b)
+			{
+				h.sumW.push_back(hist->GetBinContent(b));
+				h.sumW2.push_back(hist->GetBinError(b) * hist->GetBinError(b));
+			}
+			snapshot->histograms.push_back(h);
+		}
+		else if (auto parameter = dynamic_cast<TParameter<double> *>(object))
+		{
+			std::string name = parameter->GetName();
+			if (name == "events")
+				snapshot->events = static_cast<G4long>(parameter->GetVal());
+			else if (name == "next_event")
+				snapshot->nextEvent = static_cast<G4long>(parameter->GetVal());
+			else if (name.rfind("counter_", 0) == 0)
+				snapshot->counters[name.substr(8)] = parameter->GetVal();
+		}
+		else if (auto rng = dynamic_cast<TObjString *>(object))
+		{
+			if (snapshot->rngState.empty())
+				snapshot->rngState = rng->GetString().Data();
+		}
+		delete object;
+	}
+
+	if (!snapshot->rngState.empty())
+	{
+		std::istringstream rng(snapshot->rngState);
+		G4Random::restoreFullState(rng);
+	}
+
+	// Resumed events continue the global event numbering (seeds and beam samples)
+	if (snapshot->nextEvent <= 0)
+		snapshot->nextEvent = EventSeeder::Instance()->GetEventOffset() + snapshot->events;
+	G4UImanager::GetUIpointer()->ApplyCommand("/ats/seed/eventOffset " + std::to_string(snapshot->nextEvent));
+
+	G4cout << "[Checkpoint] Resuming from " << fileName
+		   << " | Events done: " << snapshot->events
+		   << " | Event offset: " << snapshot->nextEvent
+		   << " | Histograms: " << snapshot->histograms.size()
+		   << " | RNG restored: " << (snapshot->rngState.empty() ? "no" : "yes")
+		   << " (they are added to the next run; /run/beamOn the remaining events)" << G4endl;
+
+	fResume = std::move(snapshot);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Adds the resumed histograms and counters to the new run and keeps them as the base.
+ *
+ * Each bin is refilled with k = Sw^2/Sw2 entries of weight Sw/k, which
+ * restores Sw and Sw2 exactly and, for unweighted histograms, the entries.
+ * The refilled histograms and restored counters are then captured as the base
+ * of the run's checkpoints, in the same histogram order as the thread
+ * snapshots, with the resumed event count and next event index.
+ *
+ * @param runAction Run action of the master, which receives the counters.
+ */
+void CheckpointManager::ApplyResume(RunAction *runAction)
+{
+	auto analysisManager = G4AnalysisManager::Instance();
+	for (const RunSnapshot::Histogram &h : fResume->histograms)
+	{
+		G4int id = analysisManager->GetH1Id(h.name, false);
+		auto h1 = id >= 0 ? analysisManager->GetH1(id, false) : nullptr;
+		if (!h1 || static_cast<G4int>(h1->axis().bins()) != h.nBins)
+		{
+			G4cout << "[Checkpoint] Histogram " << h.name << " not restored (missing or different binning)" << G4endl;
+			continue;
+		}
+
+		G4double width = (h.xMax - h.xMin) / h.nBins;
+		for (G4int b = 0; b <= h.nBins + 1; ++b)
+		{
+			G4double sumW = h.sumW[b];
+			if (sumW == 0.)
+				continue;
+
+			G4double x = b == 0 ? h.xMin - width : (b == h.nBins + 1 ? h.xMax + width : h.xMin + (b - 0.5) * width);
+			G4long k = h.sumW2[b] > 0. ? std::max<G4long>(1, std::llround(sumW * sumW / h.sumW2[b])) : 1;
+			for (G4long i = 0; i < k; ++i)
+				h1->fill(x, sumW / k);
+		}
+	}
+
+	runAction->RestoreCounters(fResume->counters, fResume->events);
+
+	fBase = std::make_unique<RunSnapshot>();
+	fBase->Capture(runAction, true);
+	fBase->generation = 0;
+	fBase->events = fResume->events;
+	fBase->nextEvent = fResume->nextEvent;
+	fBaseSeparate = G4Threading::IsMultithreadedApplication();
+	fResume.reset();
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/checkpoint/ UI commands.
+ */
+void CheckpointManager::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/checkpoint/", "Periodic checkpoints and resume");
+
+	auto &eventsCmd = fMessenger->DeclareProperty("events", fEveryEvents,
+												  "Write a checkpoint every N events over all threads (0: off).");
+	eventsCmd.SetRange("events>=0");
+
+	auto &secondsCmd = fMessenger->DeclareProperty("seconds", fEverySeconds,
+												   "Write a checkpoint every T seconds of wall time (0: off).");
+	secondsCmd.SetRange("seconds>=0.");
+
+	fMessenger->DeclareProperty("file", fFileName,
+								"Base name of the checkpoint file (.root is appended).");
+
+	auto &resumeCmd = fMessenger->DeclareMethod("resume", &CheckpointManager::Resume,
+												"Restore RNG, histograms and counters from a checkpoint before /run/beamOn.");
+	resumeCmd.SetParameterName("file", false);
+	resumeCmd.SetToBeBroadcasted(false);
+}
+// ============================================================================
@@ -14,6 +14,8 @@
 #include "DetectorConstruction.hh"
 #include "MuonSensitiveDetector.hh"
 
+#include <algorithm>
+#include <cfloat>
 #include <sstream>
 
 #include "G4Box.hh"
@@ -25,6 +27,9 @@
 #include "G4SDManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4VisAttributes.hh"
+#include "G4VSolid.hh"
+
+#include "G4AutoDelete.hh"
 
 #include "G4FieldManager.hh"
 #include "G4TransportationManager.hh"
@@ -91,21 +96,23 @@ void DetectorConstruction::SetDetectorType(const G4String &type)
  */
 G4VPhysicalVolume *DetectorConstruction::Construct()
 {
+	G4VPhysicalVolume *world = nullptr;
+
 	if (fDetectorType == "muonTarget")
 	{
-		return ConstructStackedTargetGeometry();
+		world = ConstructStackedTargetGeometry();
 	}
 	else if (fDetectorType == "openMuonTarget")
 	{
-		return ConstructOpenMuonTarget();
+		world = ConstructOpenMuonTarget();
 	}
 	else if (fDetectorType == "carbonStack")
 	{
-		return ConstructCarbonStack();
+		world = ConstructCarbonStack();
 	}
 	else if (fDetectorType == "alternatingLayers")
 	{
-		return ConstructAlternatingLayers();
+		world = ConstructAlternatingLayers();
 	}
 	else
 	{
@@ -113,6 +120,57 @@ G4VPhysicalVolume *DetectorConstruction::Construct()
 					("Unknown detector type: " + fDetectorType).c_str());
 		return nullptr;
 	}
+
+	ComputeEnvelope(world);
+	return world;
+}
+
+// ============================================================================
+// Public Method: ConstructSDandField
+// ============================================================================
+
+/**
+ * @brief Attaches the muon sensitive detector and the magnetic fields.
+ *
+ * Called on the master and on every worker thread after Construct(). Sensitive
+ * detectors and field managers are thread-local objects, so they are built here
+ * rather than in the Construct*() methods:
+ * - MuonSensitiveDetector on the scoring volume (if any),
+ * - uniform 1 T field along Z over the whole world (carbonStack),
+ * - uniform 1 T field along Z restricted to the D-T gas (other geometries).
+ */
+void DetectorConstruction::ConstructSDandField()
+{
+	if (fScoringVolume)
+	{
+		auto muonSD = new MuonSensitiveDetector("MuonSD");
+		G4SDManager::GetSDMpointer()->AddNewDetector(muonSD);
+		SetSensitiveDetector(fScoringVolume, muonSD);
+	}
+
+	if (fGlobalField)
+	{
+		// Apply uniform magnetic field along Z to simulate muon guidance or confinement
+		auto field = new G4UniformMagField(G4ThreeVector(0., 0., 1.0 * tesla));
+		auto fieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+		fieldManager->SetDetectorField(field);
+		fieldManager->CreateChordFinder(field);
+		G4AutoDelete::Register(field);
+	}
+
+	if (fDTVolume)
+	{
+		// Local magnetic field inside D-T gas
+		auto localField = new G4UniformMagField(G4ThreeVector(0., 0., 1.0 * tesla));
+		auto localFieldManager = new G4FieldManager();
+		localFieldManager->SetDetectorField(localField);
+		localFieldManager->CreateChordFinder(localField);
+
+		// Assign field ONLY to D-T gas
+		fDTVolume->SetFieldManager(localFieldManager, true);
+		G4AutoDelete::Register(localField);
+		G4AutoDelete::Register(localFieldManager);
+	}
 }
 
 // ============================================================================
@@ -201,19 +259,8 @@ G4VPhysicalVolume *DetectorConstruction::ConstructCarbonStack()
 		}
 	}
 
-	if (fScoringVolume)
-	{
-		auto sdManager = G4SDManager::GetSDMpointer();
-		auto muonSD = new MuonSensitiveDetector("MuonSD");
-		sdManager->AddNewDetector(muonSD);
-		fScoringVolume->SetSensitiveDetector(muonSD);
-	}
-
-	// Apply uniform magnetic field along Z to simulate muon guidance or confinement
-	auto field = new G4UniformMagField(G4ThreeVector(0., 0., 1.0 * tesla));
-	auto fieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
-	fieldManager->SetDetectorField(field);
-	fieldManager->CreateChordFinder(field);
+	// Uniform magnetic field along Z over the whole world (built in ConstructSDandField)
+	fGlobalField = true;
 
 	G4cout << "=== Target Layer Summary ===" << G4endl;
 	for (size_t i = 0; i < fTargetVolumes.size(); ++i)
@@ -285,14 +332,6 @@ G4VPhysicalVolume *DetectorConstruction::ConstructAlternatingLayers()
 		}
 	}
 
-	if (fScoringVolume)
-	{
-		auto sdManager = G4SDManager::GetSDMpointer();
-		auto muonSD = new MuonSensitiveDetector("MuonSD");
-		sdManager->AddNewDetector(muonSD);
-		fScoringVolume->SetSensitiveDetector(muonSD);
-	}
-
 	// ------------------------------
 	// Add D-T Gas Region with Local Magnetic Field
 	// ------------------------------
@@ -324,14 +363,8 @@ G4VPhysicalVolume *DetectorConstruction::ConstructAlternatingLayers()
 	new G4PVPlacement(0, G4ThreeVector(0, 0, DT_zPos), logicDT, "DTGasPhysical", logicWorld, false, 0);
 	logicDT->SetVisAttributes(new G4VisAttributes(G4Colour(0.0, 1.0, 1.0))); // Cyan
 
-	// Local magnetic field inside D-T gas
-	auto localField = new G4UniformMagField(G4ThreeVector(0., 0., 1.0 * tesla));
-	auto localFieldManager = new G4FieldManager();
-	localFieldManager->SetDetectorField(localField);
-	localFieldManager->CreateChordFinder(localField);
-
-	// Assign field ONLY to D-T gas
-	logicDT->SetFieldManager(localFieldManager, true);
+	// Local magnetic field inside D-T gas (built in ConstructSDandField)
+	fDTVolume = logicDT;
 
 	// (optional) make this the scoring volume if desired
 	// fScoringVolume = logicDT;
@@ -377,6 +410,7 @@ G4VPhysicalVolume *DetectorConstruction::ConstructStackedTargetGeometry()
 	logicTarget->SetVisAttributes(new G4VisAttributes(G4Colour::Brown()));
 
 	fScoringVolume = logicTarget;
+	fProductionTargetVolume = logicTarget;
 
 	G4double startZ = -10 * cm + targetThickness + 1.0 * mm;
 	for (G4int i = 0; i < numConverters; ++i)
@@ -391,14 +425,6 @@ G4VPhysicalVolume *DetectorConstruction::ConstructStackedTargetGeometry()
 		fTargetVolumes.push_back(logicConv);
 	}
 
-	if (fScoringVolume)
-	{
-		auto sdManager = G4SDManager::GetSDMpointer();
-		auto muonSD = new MuonSensitiveDetector("MuonSD");
-		sdManager->AddNewDetector(muonSD);
-		fScoringVolume->SetSensitiveDetector(muonSD);
-	}
-
 	// ------------------------------
 	// Add D-T Gas Region with Local Magnetic Field
 	// ------------------------------
@@ -428,6 +454,7 @@ G4VPhysicalVolume *DetectorConstruction::ConstructStackedTargetGeometry()
 	fDTZCenter = DT_zPos;					  //  Z-center of D-T gas region (midpoint).
 	fDTZStart = DT_zPos - DT_thickness / 2.0; // Z-start of D-T gas region (front face).
 	fDTZEnd = DT_zPos + DT_thickness / 2.0;	  // Z-end of D-T gas region (back face).
+	fConverterZEnd = lastConverterZ + converterThickness / 2;
 
 	auto solidDT = new G4Box("DTGasBox", DT_width / 2.0, DT_height / 2.0, DT_thickness / 2.0);
 	auto logicDT = new G4LogicalVolume(solidDT, DTGas, "DTGasLogical");
@@ -435,14 +462,8 @@ G4VPhysicalVolume *DetectorConstruction::ConstructStackedTargetGeometry()
 	new G4PVPlacement(0, G4ThreeVector(0, 0, DT_zPos), logicDT, "DTGasPhysical", logicWorld, false, 0);
 	logicDT->SetVisAttributes(new G4VisAttributes(G4Colour(0.0, 1.0, 1.0))); // Cyan
 
-	// Local magnetic field inside D-T gas
-	auto localField = new G4UniformMagField(G4ThreeVector(0., 0., 1.0 * tesla));
-	auto localFieldManager = new G4FieldManager();
-	localFieldManager->SetDetectorField(localField);
-	localFieldManager->CreateChordFinder(localField);
-
-	// Assign field ONLY to D-T gas
-	logicDT->SetFieldManager(localFieldManager, true);
+	// Local magnetic field inside D-T gas (built in ConstructSDandField)
+	fDTVolume = logicDT;
 
 	// Debug output (optional)
 	G4cout << "[DEBUG] D-T gas region placed at Z = " << DT_zPos / mm << " mm" << G4endl;
@@ -494,6 +515,7 @@ G4VPhysicalVolume *DetectorConstruction::ConstructOpenMuonTarget()
 	new G4PVPlacement(0, G4ThreeVector(0, 0, -10 * cm), logicTarget, "ProtonTarget", logicWorld, false, 0);
 	logicTarget->SetVisAttributes(new G4VisAttributes(G4Colour::Brown()));
 	fScoringVolume = logicTarget;
+	fProductionTargetVolume = logicTarget;
 
 	// --- Gradient tungsten stack ---
 	G4double zPos = -10 * cm + targetThickness + 1.0 * mm;
@@ -529,30 +551,53 @@ G4VPhysicalVolume *DetectorConstruction::ConstructOpenMuonTarget()
 	fDTZCenter = DT_zPos;
 	fDTZStart = DT_zPos - DT_thickness / 2.0;
 	fDTZEnd = DT_zPos + DT_thickness / 2.0;
+	fConverterZEnd = zPos - gap; // back face of the last converter
 
 	auto solidDT = new G4Box("DTGasBox", DT_width / 2.0, DT_height / 2.0, DT_thickness / 2.0);
 	auto logicDT = new G4LogicalVolume(solidDT, DTGas, "DTGasLogical");
 	new G4PVPlacement(0, G4ThreeVector(0, 0, DT_zPos), logicDT, "DTGasPhysical", logicWorld, false, 0);
 	logicDT->SetVisAttributes(new G4VisAttributes(G4Colour(0.0, 1.0, 1.0))); // Cyan
 
-	// Magnetic field in D-T region
-	auto localField = new G4UniformMagField(G4ThreeVector(0., 0., 1.0 * tesla));
-	auto localFieldManager = new G4FieldManager();
-	localFieldManager->SetDetectorField(localField);
-	localFieldManager->CreateChordFinder(localField);
-	logicDT->SetFieldManager(localFieldManager, true);
+	// Magnetic field in D-T region (built in ConstructSDandField)
+	fDTVolume = logicDT;
 
 	G4cout << "[DEBUG] D-T gas region (gradient converter geometry) placed at Z = " << DT_zPos / mm << " mm" << G4endl;
 
-	// --- Sensitive Detector ---
-	if (fScoringVolume)
+	return physWorld;
+}
+// ============================================================================
+
+// ============================================================================
+// Private Method: ComputeEnvelope
+// ============================================================================
+
+/**
+ * @brief Builds the axis-aligned box enclosing every daughter of the world volume.
+ *
+ * None of the geometries rotate their placements, so the bounding limits of each
+ * solid shifted by its translation are exact.
+ *
+ * @param world Pointer to the world physical volume.
+ */
+void DetectorConstruction::ComputeEnvelope(const G4VPhysicalVolume *world)
+{
+	G4LogicalVolume *logicWorld = world->GetLogicalVolume();
+	G4ThreeVector lo(DBL_MAX, DBL_MAX, DBL_MAX);
+	G4ThreeVector hi(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+
+	for (size_t i = 0; i < logicWorld->GetNoDaughters(); ++i)
 	{
-		auto sdManager = G4SDManager::GetSDMpointer();
-		auto muonSD = new MuonSensitiveDetector("MuonSD");
-		sdManager->AddNewDetector(muonSD);
-		fScoringVolume->SetSensitiveDetector(muonSD);
+		G4VPhysicalVolume *daughter = logicWorld->GetDaughter(i);
+		G4ThreeVector pMin, pMax;
+		daughter->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin, pMax);
+		pMin += daughter->GetTranslation();
+		pMax += daughter->GetTranslation();
+
+		lo.set(std::min(lo.x(), pMin.x()), std::min(lo.y(), pMin.y()), std::min(lo.z(), pMin.z()));
+		hi.set(std::max(hi.x(), pMax.x()), std::max(hi.y(), pMax.y()), std::max(hi.z(), pMax.z()));
 	}
 
-	return physWorld;
+	fEnvelopeMin = lo;
+	fEnvelopeMax = hi;
 }
-// ============================================================================
\ No newline at end of file
+// ============================================================================
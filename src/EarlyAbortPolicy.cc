@@ -0,0 +1,210 @@
+// ============================================================================
+//  File   : EarlyAbortPolicy.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the opt-in early event abort. Energetic hadrons inside
+//           the production target are counted per event; once they have all
+//           left without a muon precursor appearing, the event is aborted.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "EarlyAbortPolicy.hh"
+#include "DetectorConstruction.hh"
+#include "MuonAncestry.hh"
+#include "SubEventParallelism.hh"
+
+#include "G4EventManager.hh"
+#include "G4GenericMessenger.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4RunManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Constructor
+ *
+ * The default hadron threshold (280 MeV) is just below the nucleon-nucleon
+ * single-pion production threshold.
+ */
+EarlyAbortPolicy::EarlyAbortPolicy()
+	: fHadronThreshold(280. * MeV)
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+EarlyAbortPolicy::~EarlyAbortPolicy()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Per-Event Logic
+// ============================================================================
+
+/**
+ * @brief Clears the per-event state.
+ * @param nPrimaries Number of primaries of the event.
+ */
+void EarlyAbortPolicy::BeginEvent(G4int nPrimaries)
+{
+	fNumPrimaries = nPrimaries;
+	fPrimariesStarted = 0;
+	fPending = 0;
+	fArmed = false;
+	fPrecursorSeen = false;
+	fAborted = false;
+	fInside.clear();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Updates the target bookkeeping for one step and aborts the event if due.
+ *
+ * Nothing is done once a precursor has been seen or the event was aborted, so
+ * the cost for muon-producing events is a single branch per step.
+ *
+ * @param step Pointer to the current G4Step.
+ */
+void EarlyAbortPolicy::ProcessStep(const G4Step *step)
+{
+	if (!fEnabled || fAborted || fPrecursorSeen || SubEventParallelism::IsActive())
+		return;
+
+	if (!fTargetResolved)
+	{
+		auto detector = static_cast<const DetectorConstruction *>(
+			G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+		fTarget = detector ? detector->GetProductionTargetVolume() : nullptr;
+		fTargetResolved = true;
+	}
+	if (!fTarget)
+		return;
+
+	const G4Track *track = step->GetTrack();
+	if (track->GetParentID() == 0 && track->GetCurrentStepNumber() == 1)
+	{
+		++fPrimariesStarted;
+	}
+
+	const G4ParticleDefinition *particle = track->GetDefinition();
+	if (IsPrecursor(particle))
+	{
+		fPrecursorSeen = true;
+		return;
+	}
+
+	G4LogicalVolume *preVolume = step->GetPreStepPoint()->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
+	const G4VPhysicalVolume *postPhys = step->GetPostStepPoint()->GetPhysicalVolume();
+	G4LogicalVolume *postVolume = postPhys ? postPhys->GetLogicalVolume() : nullptr;
+	G4bool wasInside = (preVolume == fTarget);
+	G4int trackID = track->GetTrackID();
+
+	// Created inside the target: its parent already counted it, just remember the ID
+	if (wasInside && track->GetCurrentStepNumber() == 1 && track->GetLogicalVolumeAtVertex() == fTarget &&
+		IsEnergeticHadron(particle, track->GetVertexKineticEnergy()))
+	{
+		fInside.insert(trackID);
+	}
+
+	// Entering the target from outside
+	if (!wasInside && postVolume == fTarget && IsEnergeticHadron(particle, track->GetKineticEnergy()))
+	{
+		if (fInside.insert(trackID).second)
+		{
+			++fPending;
+			fArmed = true;
+		}
+	}
+
+	// Secondaries produced inside the target
+	if (wasInside)
+	{
+		for (const G4Track *secondary : *step->GetSecondaryInCurrentStep())
+		{
+			if (IsPrecursor(secondary->GetDefinition()))
+			{
+				fPrecursorSeen = true;
+				return;
+			}
+			if (IsEnergeticHadron(secondary->GetDefinition(), secondary->GetKineticEnergy()))
+			{
+				++fPending;
+				fArmed = true;
+			}
+		}
+	}
+
+	// Leaving the target or ending inside it
+	if (wasInside && (postVolume != fTarget || track->GetTrackStatus() != fAlive))
+	{
+		if (fInside.erase(trackID) > 0)
+		{
+			--fPending;
+		}
+	}
+
+	// Primaries still waiting on the stack may yet produce a precursor
+	if (fArmed && fPending == 0 && fPrimariesStarted >= fNumPrimaries)
+	{
+		fAborted = true;
+		G4EventManager::GetEventManager()->AbortCurrentEvent();
+	}
+}
+
+// ============================================================================
+// Private Helpers
+// ============================================================================
+
+/**
+ * @brief Returns true for muons and their possible ancestors (MuonAncestry::IsMuonAncestor()).
+ *
+ * Neutral kaons and hyperons count at any energy: they decay to charged pions.
+ */
+G4bool EarlyAbortPolicy::IsPrecursor(const G4ParticleDefinition *particle) const
+{
+	return MuonAncestry::IsMuonAncestor(particle);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns true for baryons and mesons above the pion-production threshold.
+ */
+G4bool EarlyAbortPolicy::IsEnergeticHadron(const G4ParticleDefinition *particle, G4double kineticEnergy) const
+{
+	if (kineticEnergy < fHadronThreshold)
+		return false;
+
+	const G4String &type = particle->GetParticleType();
+	return type == "baryon" || type == "meson";
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Declares the /ats/abort/ UI commands.
+ */
+void EarlyAbortPolicy::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/abort/", "Early abort of events without muon precursors");
+
+	fMessenger->DeclareProperty("noPrecursor", fEnabled,
+								"Abort events once all hadrons left ProtonTargetLV without a muon precursor.");
+
+	auto &thresholdCmd = fMessenger->DeclarePropertyWithUnit(
+		"hadronThreshold", "MeV", fHadronThreshold,
+		"Hadrons below this kinetic energy are not tracked by the policy.");
+	thresholdCmd.SetRange("hadronThreshold>=0.");
+}
+// ============================================================================
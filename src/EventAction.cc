@@ -13,49 +13,231 @@
 // ============================================================================
 
 #include "EventAction.hh"
+#include "CheckpointManager.hh"
+#include "EarlyAbortPolicy.hh"
+#include "EventDisplayWriter.hh"
+#include "EventLatency.hh"
+#include "KeptEventManager.hh"
+#include "LiveMonitor.hh"
+#include "PerfCounters.hh"
+#include "RunInterrupt.hh"
+#include "SlowEventMonitor.hh"
+#include "SubEventParallelism.hh"
+#include "RunAction.hh"
+
+#include "G4AnalysisManager.hh"
 #include "G4Event.hh"
 #include "G4EventManager.hh"
 #include "G4RunManager.hh"
+
+#include <algorithm>
 // ============================================================================
 // EventAction Class Implementation
 // ============================================================================
 /**
- * @brief Constructor initializes the internal flag.
+ * @brief Constructor initializes the internal flag and the early-abort policy.
  */
 EventAction::EventAction()
 	: G4UserEventAction(), fKeepThisEvent(false)
 {
+	fEarlyAbortPolicy = new EarlyAbortPolicy();
+	fKeptEventManager = new KeptEventManager();
+	fPerfCounters = PerfCounters::Instance();
+	fSlowEventMonitor = SlowEventMonitor::Instance();
+	fEventDisplayWriter = EventDisplayWriter::Instance();
+	fCheckpointManager = CheckpointManager::Instance();
+	fLiveMonitor = LiveMonitor::Instance();
 }
 // ----------------------------------------------------------------------------
 /**
  * @brief Destructor.
  */
-EventAction::~EventAction() {}
+EventAction::~EventAction()
+{
+	delete fEarlyAbortPolicy;
+	delete fKeptEventManager;
+}
 // ----------------------------------------------------------------------------
 /**
  * @brief Called at the beginning of each event.
- * Resets the internal event retention flag.
- * @param event Pointer to the current event.
+ * Resets the internal event retention flag and the per-primary muon counts.
+ * @param event Pointer to the current event (its primaries are already generated).
  */
-void EventAction::BeginOfEventAction(const G4Event *)
+void EventAction::BeginOfEventAction(const G4Event *event)
 {
 	// Reset event retention flag
 	fKeepThisEvent = false;
+	fMuonStopInDT = false;
+	fDTStopWeight = 0.;
+	fNumSteps = 0;
+
+	// Sub-events (sub-event parallel mode) carry shipped shower tracks and no primaries
+	fSubEvent = SubEventParallelism::IsSubEvent(event);
+	G4int nPrimaries = event->GetNumberOfPrimaryVertex();
+	fMuonsPerPrimary.assign(static_cast<size_t>(nPrimaries), 0.);
+	fPrimaryOfTrack.clear();
+	fSubEventMuons = 0.;
+
+	fEarlyAbortPolicy->BeginEvent(std::max(1, nPrimaries));
+
+	// Soft abort after SIGINT/SIGTERM: the events in flight still finish
+	RunInterrupt::Poll();
+
+	// Per-event hardware counters (no-op unless /ats/perf/mode event)
+	fPerfCounters->BeginOfEvent();
+
+	// Event timer for slow-event capture (no-op unless /ats/slow/enable)
+	fSlowEventMonitor->BeginEvent();
+
+	// In-run event latency (benchmark); sub-events extend their parent event
+	if (EventLatency::IsEnabled() && !fSubEvent)
+	{
+		EventLatency::BeginEvent(event->GetEventID());
+	}
+
+	// Creator tags of this event's tracks (no-op unless /ats/display/enable)
+	if (fEventDisplayWriter->IsEnabled())
+	{
+		fEventDisplayWriter->BeginEvent();
+	}
 }
 // ----------------------------------------------------------------------------
 /**
  * @brief Called at the end of each event.
- * Instructs Geant4 to keep the event if flagged.
+ * Instructs Geant4 to keep the event if flagged and selected by the
+ * KeptEventManager (at most /ats/keep/maxEvents per run), and reports events aborted
+ * by the early-abort policy to RunAction for normalization. The step and
+ * primary counts of the event are handed to RunAction as well, and the muons
+ * of each primary go to the MuonsPerPrimary histogram (aborted events included,
+ * with zero muons, so its entries equal the protons on target). Sub-events
+ * add no primaries and are never kept; muons created in them are reported to
+ * RunAction separately. The weighted D-T stops of the event go to RunAction
+ * for the figure of merit.
  * @param event Pointer to the current event.
  */
-void EventAction::EndOfEventAction(const G4Event *)
+void EventAction::EndOfEventAction(const G4Event *event)
+{
+	fPerfCounters->EndOfEvent();
+	fSlowEventMonitor->EndEvent(event);
+
+	auto runAction = const_cast<RunAction *>(
+		static_cast<const RunAction *>(G4RunManager::GetRunManager()->GetUserRunAction()));
+	if (runAction)
+	{
+		runAction->RecordSteps(fNumSteps);
+		runAction->RecordPrimaries(static_cast<G4int>(fMuonsPerPrimary.size()));
+		runAction->RecordDTStops(fDTStopWeight);
+		if (fSubEventMuons > 0.)
+		{
+			runAction->RecordSubEventMuons(fSubEventMuons);
+		}
+	}
+
+	auto analysisManager = G4AnalysisManager::Instance();
+	for (G4double muons : fMuonsPerPrimary)
+	{
+		analysisManager->FillH1(8, muons); // Histogram 8: MuonsPerPrimary
+	}
+
+	if (fEarlyAbortPolicy->AbortedThisEvent())
+	{
+		if (runAction)
+		{
+			runAction->RecordAbortedEvent();
+		}
+	}
+	else if (!fSubEvent)
+	{
+		// Every muon event goes to the offline display file (opt-in)
+		if (fKeepThisEvent && fEventDisplayWriter->IsEnabled())
+		{
+			fEventDisplayWriter->WriteEvent(event);
+		}
+
+		// Only keep the event if it was flagged and wins a place in the reservoir
+		if (fKeepThisEvent && fKeptEventManager->Offer(event, fMuonStopInDT))
+		{
+			G4EventManager::GetEventManager()->KeepTheCurrentEvent();
+		}
+		// Otherwise: do NOT call it at all
+	}
+
+	// Publish a checkpoint snapshot once this event is fully accounted for (opt-in)
+	if (runAction && fCheckpointManager->IsEnabled())
+	{
+		fCheckpointManager->EndOfEvent(runAction, event->GetEventID());
+	}
+
+	// Live monitor snapshot (opt-in)
+	if (runAction && fLiveMonitor->IsEnabled())
+	{
+		fLiveMonitor->EndOfEvent(runAction);
+	}
+
+	if (EventLatency::IsEnabled())
+	{
+		EventLatency::EndEvent(event->GetEventID());
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Maps a new track to the primary it descends from.
+ *
+ * Primary k has track ID k + 1, and a parent is always transported before its
+ * secondaries, so the parent's entry exists. Track IDs are consecutive, hence
+ * the flat table. Single-primary events need no table and skip it.
+ *
+ * @param trackID ID of the track about to be transported.
+ * @param parentID ID of its parent (0 for primaries).
+ */
+void EventAction::RecordTrack(G4int trackID, G4int parentID)
+{
+	if (fMuonsPerPrimary.size() <= 1 || trackID <= 0)
+		return;
+
+	size_t id = static_cast<size_t>(trackID);
+	if (fPrimaryOfTrack.size() <= id)
+	{
+		fPrimaryOfTrack.resize(id + 1, -1);
+	}
+
+	if (parentID == 0)
+	{
+		fPrimaryOfTrack[id] = trackID - 1;
+	}
+	else if (static_cast<size_t>(parentID) < fPrimaryOfTrack.size())
+	{
+		fPrimaryOfTrack[id] = fPrimaryOfTrack[static_cast<size_t>(parentID)];
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Credits a newly created muon to the primary it descends from.
+ *
+ * In single-primary events everything goes to primary 0. In a sub-event
+ * (shipped shower tracks, e.g. a gamma or neutron that produced a pion) there
+ * is no primary: the muon is counted apart.
+ *
+ * @param trackID Track ID of the muon.
+ * @param weight Statistical weight of the muon.
+ */
+void EventAction::RecordMuon(G4int trackID, G4double weight)
 {
-	// Only keep the event if it was flagged
-	if (fKeepThisEvent)
+	if (fSubEvent)
+	{
+		fSubEventMuons += weight;
+		return;
+	}
+
+	size_t id = static_cast<size_t>(trackID);
+	G4int primaryIndex = id < fPrimaryOfTrack.size() ? fPrimaryOfTrack[id] : -1;
+	size_t slot = primaryIndex > 0 ? static_cast<size_t>(primaryIndex) : 0;
+	if (slot < fMuonsPerPrimary.size())
 	{
-		G4EventManager::GetEventManager()->KeepTheCurrentEvent();
+		fMuonsPerPrimary[slot] += weight;
 	}
-	// Otherwise: do NOT call it at all
 }
 
 // ----------------------------------------------------------------------------
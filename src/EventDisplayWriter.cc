@@ -0,0 +1,212 @@
+// ============================================================================
+//  File   : EventDisplayWriter.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the compact binary event-display output of muon
+//           events (delta-encoded float32 trajectory points).
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "EventDisplayWriter.hh"
+#include "EventDisplayFormat.hh"
+
+#include "G4AutoDelete.hh"
+#include "G4Event.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4Track.hh"
+#include "G4TrajectoryContainer.hh"
+#include "G4VProcess.hh"
+#include "G4VTrajectory.hh"
+#include "G4VTrajectoryPoint.hh"
+#include "G4ios.hh"
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the writer of the calling thread, deleted at thread exit.
+ */
+EventDisplayWriter *EventDisplayWriter::Instance()
+{
+	static G4ThreadLocal EventDisplayWriter *instance = nullptr;
+	if (!instance)
+	{
+		instance = new EventDisplayWriter();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ */
+EventDisplayWriter::EventDisplayWriter()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+EventDisplayWriter::~EventDisplayWriter()
+{
+	if (fOutput.is_open())
+	{
+		fOutput.close();
+		G4cout << "[EventDisplay] Thread " << G4Threading::G4GetThreadId()
+			   << " | Events written: " << fNumEvents << G4endl;
+	}
+	delete fMessenger;
+}
+
+// ============================================================================
+// Per-Track / Per-Event Output
+// ============================================================================
+
+/**
+ * @brief Records the creator process of a new track.
+ *
+ * The tag is the coarse G4ProcessType of the creator, which is what the
+ * display needs (decay vs. hadronic vs. electromagnetic) in one byte.
+ */
+void EventDisplayWriter::RecordTrack(const G4Track *track)
+{
+	using namespace EventDisplayFormat;
+
+	G4int trackID = track->GetTrackID();
+	if (trackID >= static_cast<G4int>(fProcessTags.size()))
+		fProcessTags.resize(trackID + 1, kOther);
+
+	const G4VProcess *creator = track->GetCreatorProcess();
+	std::uint8_t tag = kPrimary;
+	if (creator)
+	{
+		switch (creator->GetProcessType())
+		{
+		case fDecay:
+			tag = kDecay;
+			break;
+		case fHadronic:
+			tag = kHadronic;
+			break;
+		case fElectromagnetic:
+			tag = kElectromagnetic;
+			break;
+		default:
+			tag = kOther;
+			break;
+		}
+	}
+	fProcessTags[trackID] = tag;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Appends the trajectories of an event to the file.
+ *
+ * Each point is stored as the float32 difference to the previous point as it
+ * will be reconstructed by the reader, so rounding errors do not accumulate.
+ *
+ * @param event Finished event.
+ */
+void EventDisplayWriter::WriteEvent(const G4Event *event)
+{
+	using namespace EventDisplayFormat;
+
+	G4TrajectoryContainer *trajectories = event->GetTrajectoryContainer();
+	if (!trajectories)
+		return;
+
+	if (!fOutput.is_open())
+		Open();
+
+	const G4Run *run = G4RunManager::GetRunManager()->GetCurrentRun();
+	Put<std::int32_t>(run ? run->GetRunID() : 0);
+	Put<std::int32_t>(event->GetEventID());
+
+	std::uint32_t nTrajectories = 0;
+	for (G4int i = 0; i < static_cast<G4int>(trajectories->entries()); ++i)
+	{
+		if ((*trajectories)[i]->GetPointEntries() > 0)
+			++nTrajectories;
+	}
+	Put<std::uint32_t>(nTrajectories);
+
+	for (G4int i = 0; i < static_cast<G4int>(trajectories->entries()); ++i)
+	{
+		const G4VTrajectory *trajectory = (*trajectories)[i];
+		G4int nPoints = trajectory->GetPointEntries();
+		if (nPoints == 0)
+			continue;
+
+		G4int trackID = trajectory->GetTrackID();
+		std::uint8_t tag = trackID < static_cast<G4int>(fProcessTags.size()) ? fProcessTags[trackID] : kOther;
+
+		Put<std::int32_t>(trackID);
+		Put<std::int32_t>(trajectory->GetParentID());
+		Put<std::int32_t>(trajectory->GetPDGEncoding());
+		Put<std::uint8_t>(tag);
+		Put<std::uint32_t>(nPoints);
+
+		float previous[3] = {0.f, 0.f, 0.f};
+		for (G4int p = 0; p < nPoints; ++p)
+		{
+			G4ThreeVector pos = trajectory->GetPoint(p)->GetPosition() / mm;
+			G4double coords[3] = {pos.x(), pos.y(), pos.z()};
+			for (G4int k = 0; k < 3; ++k)
+			{
+				float value = static_cast<float>(coords[k] - previous[k]);
+				Put<float>(value);
+				previous[k] += value;
+			}
+		}
+	}
+
+	++fNumEvents;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Opens <file>[_t<thread>].atsd and writes the header.
+ */
+void EventDisplayWriter::Open()
+{
+	G4String name = fFileName;
+	if (G4Threading::IsWorkerThread())
+		name += "_t" + std::to_string(G4Threading::G4GetThreadId());
+	name += ".atsd";
+
+	fOutput.open(name, std::ios::binary | std::ios::trunc);
+	fOutput.write(EventDisplayFormat::kMagic, sizeof(EventDisplayFormat::kMagic));
+	Put<std::uint32_t>(EventDisplayFormat::kVersion);
+
+	G4cout << "[EventDisplay] Writing muon events to " << name << G4endl;
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/display/ UI commands.
+ */
+void EventDisplayWriter::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/display/", "Offline event-display output");
+
+	fMessenger->DeclareProperty("enable", fEnabled,
+								"Write the trajectories of muon events to a compact binary file.");
+
+	fMessenger->DeclareProperty("file", fFileName,
+								"Base name of the output file (_t<thread> and .atsd are appended).");
+}
+// ============================================================================
@@ -0,0 +1,114 @@
+// ============================================================================
+//  File   : EventLatency.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the in-run event latency measurement.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "EventLatency.hh"
+
+#include <algorithm>
+
+std::atomic<G4bool> EventLatency::fEnabled{false};
+std::mutex EventLatency::fMutex;
+std::map<G4int, EventLatency::Interval> EventLatency::fEvents;
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+/**
+ * @brief Starts the clock of an event.
+ */
+void EventLatency::BeginEvent(G4int eventID)
+{
+	auto now = Clock::now();
+	std::lock_guard<std::mutex> lock(fMutex);
+	Interval &interval = fEvents[eventID];
+	interval.start = now;
+	interval.ended = false;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Moves the end of an event to now.
+ *
+ * Sub-events may finish before or after the thread that tracked the event
+ * itself, so the latest end wins. Ends of events that were not started are
+ * ignored.
+ */
+void EventLatency::EndEvent(G4int eventID)
+{
+	auto now = Clock::now();
+	std::lock_guard<std::mutex> lock(fMutex);
+	auto it = fEvents.find(eventID);
+	if (it == fEvents.end())
+		return;
+
+	Interval &interval = it->second;
+	interval.end = interval.ended ? std::max(interval.end, now) : now;
+	interval.ended = true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Forgets all events.
+ */
+void EventLatency::Reset()
+{
+	std::lock_guard<std::mutex> lock(fMutex);
+	fEvents.clear();
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * @brief Returns the number of events with a measured latency.
+ */
+G4int EventLatency::GetNumberOfEvents()
+{
+	std::lock_guard<std::mutex> lock(fMutex);
+	return static_cast<G4int>(
+		std::count_if(fEvents.begin(), fEvents.end(), [](const auto &entry) { return entry.second.ended; }));
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the mean latency [s] of the measured events.
+ */
+G4double EventLatency::GetMeanSeconds()
+{
+	std::lock_guard<std::mutex> lock(fMutex);
+	G4double sum = 0.;
+	G4int n = 0;
+	for (const auto &[eventID, interval] : fEvents)
+	{
+		if (!interval.ended)
+			continue;
+		sum += std::chrono::duration<G4double>(interval.end - interval.start).count();
+		++n;
+	}
+	return n > 0 ? sum / n : 0.;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the longest latency [s] of the measured events.
+ */
+G4double EventLatency::GetMaxSeconds()
+{
+	std::lock_guard<std::mutex> lock(fMutex);
+	G4double longest = 0.;
+	for (const auto &[eventID, interval] : fEvents)
+	{
+		if (interval.ended)
+			longest = std::max(longest, std::chrono::duration<G4double>(interval.end - interval.start).count());
+	}
+	return longest;
+}
+// ============================================================================
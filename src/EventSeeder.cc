@@ -0,0 +1,126 @@
+// ============================================================================
+//  File   : EventSeeder.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements per-event seeding from (master seed, run ID, event ID).
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "EventSeeder.hh"
+
+#include "G4AutoDelete.hh"
+#include "G4GenericMessenger.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+
+#include <string>
+
+std::atomic<long> EventSeeder::fRunSeed{0};
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the instance of the calling thread, deleted at thread exit.
+ */
+EventSeeder *EventSeeder::Instance()
+{
+	static G4ThreadLocal EventSeeder *instance = nullptr;
+	if (!instance)
+	{
+		instance = new EventSeeder();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ */
+EventSeeder::EventSeeder()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+EventSeeder::~EventSeeder()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Seeding
+// ============================================================================
+
+/**
+ * @brief Fixes the master seed of the new run.
+ *
+ * The master begins the run before the workers, so they all see its value.
+ * Without /ats/seed/master the engine seed is used, captured before the first
+ * SeedEvent(): in sequential mode SeedEvent() reseeds this very engine, whose
+ * seed afterwards is the last event ID of the previous run. It is captured
+ * again only if it changed since (e.g. /random/setSeeds between runs).
+ *
+ * @param master True on the master (or sequential) thread.
+ */
+void EventSeeder::BeginOfRun(G4bool master)
+{
+	if (!master || !fEnabled)
+		return;
+
+	long engineSeed = G4Random::getTheSeed();
+	if (fEngineSeed < 0 || engineSeed != fLastEventSeed)
+		fEngineSeed = engineSeed;
+
+	fRunSeed = fMasterSeed > 0 ? static_cast<long>(fMasterSeed) : fEngineSeed;
+	G4cout << "[Seed] Per-event seeding from master seed " << fRunSeed.load()
+		   << (fEventOffset > 0 ? ", event offset " + std::to_string(fEventOffset) : std::string()) << G4endl;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Seeds the engine of this thread for one event.
+ *
+ * The three seeds are the stream IDs of MixMax's skip-ahead seeding, so the
+ * state depends only on the tuple, never on earlier events of the thread.
+ *
+ * @param runID Run ID of the event.
+ * @param eventID Event ID within the run.
+ */
+void EventSeeder::SeedEvent(G4int runID, G4int eventID) const
+{
+	long seeds[3] = {static_cast<long>(fEventOffset) + eventID, runID, fRunSeed.load(std::memory_order_relaxed)};
+	G4Random::setTheSeeds(seeds, 3);
+	fLastEventSeed = G4Random::getTheSeed();
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/seed/ UI commands.
+ */
+void EventSeeder::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/seed/", "Per-event reproducible seeding");
+
+	fMessenger->DeclareProperty("perEvent", fEnabled,
+								"Seed every event from (master seed, run ID, event ID), independent of threads.");
+
+	auto &masterCmd = fMessenger->DeclareProperty("master", fMasterSeed,
+												  "Master seed of the per-event streams (0: engine seed at run start).");
+	masterCmd.SetRange("master>=0");
+
+	auto &offsetCmd = fMessenger->DeclareProperty("eventOffset", fEventOffset,
+												  "Offset added to the event IDs (global numbering of a job).");
+	offsetCmd.SetRange("eventOffset>=0");
+}
+// ============================================================================
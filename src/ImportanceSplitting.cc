@@ -0,0 +1,229 @@
+// ============================================================================
+//  File   : ImportanceSplitting.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements geometric importance splitting and Russian roulette for
+//           muons and pions in the drift region in front of the D-T gas cell.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "ImportanceSplitting.hh"
+#include "DetectorConstruction.hh"
+#include "TrackInformation.hh"
+
+#include "G4DynamicParticle.hh"
+#include "G4GenericMessenger.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4PionMinus.hh"
+#include "G4PionPlus.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Constructor
+ *
+ * Defaults: up to 4 slabs of at least 10 mm with an importance ratio of 2, i.e.
+ * with the full 4 slabs muons reaching the D-T cell are split 32-fold relative
+ * to the converter stack.
+ */
+ImportanceSplitting::ImportanceSplitting(const DetectorConstruction *detectorConstruction)
+	: fDetectorConstruction(detectorConstruction),
+	  fMinCellWidth(10. * mm)
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+ImportanceSplitting::~ImportanceSplitting()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Apply
+// ============================================================================
+
+/**
+ * @brief Applies splitting or Russian roulette on cell crossings.
+ *
+ * @param step Pointer to the current G4Step.
+ * @param secondaries Secondary vector of the stepping manager; clones are appended.
+ * @return True if the track lost the Russian roulette and was killed.
+ */
+G4bool ImportanceSplitting::Apply(const G4Step *step, G4TrackVector *secondaries)
+{
+	if (!fEnabled)
+		return false;
+
+	G4Track *track = step->GetTrack();
+	if (track->GetTrackStatus() != fAlive || !IsBiased(track->GetDefinition()))
+		return false;
+
+	G4int nSlabs = GetNumberOfSlabs();
+	if (nSlabs < 1)
+		return false;
+
+	G4int preCell = GetCell(step->GetPreStepPoint()->GetPosition().z(), nSlabs);
+	G4int postCell = GetCell(step->GetPostStepPoint()->GetPosition().z(), nSlabs);
+	if (preCell == postCell)
+		return false;
+
+	// Expected number of copies after the crossing: I(post) / I(pre)
+	G4double expected = std::pow(fRatio, postCell - preCell);
+	G4double weight = track->GetWeight();
+
+	if (expected < 1.)
+	{
+		// Russian roulette toward lower importance
+		if (G4UniformRand() < expected)
+		{
+			track->SetWeight(weight / expected);
+			return false;
+		}
+
+		auto info = static_cast<TrackInformation *>(track->GetUserInformation());
+		if (!info)
+		{
+			info = new TrackInformation();
+			track->SetUserInformation(info);
+		}
+		info->SetRouletteKilled(true);
+		track->SetTrackStatus(fStopAndKill);
+		return true;
+	}
+
+	// Splitting toward higher importance
+	G4int nCopies = static_cast<G4int>(expected);
+	if (G4UniformRand() < expected - nCopies)
+		++nCopies;
+	nCopies = std::min(nCopies, fMaxSplit);
+	if (nCopies <= 1)
+		return false;
+
+	G4double newWeight = weight / nCopies;
+	track->SetWeight(newWeight);
+
+	auto parentInfo = static_cast<const TrackInformation *>(track->GetUserInformation());
+	for (G4int i = 1; i < nCopies; ++i)
+	{
+		auto clone = new G4Track(new G4DynamicParticle(*track->GetDynamicParticle()),
+								 track->GetGlobalTime(), track->GetPosition());
+		clone->SetWeight(newWeight);
+		clone->SetParentID(track->GetTrackID());
+		clone->SetTouchableHandle(step->GetPostStepPoint()->GetTouchableHandle());
+		clone->SetCreatorProcess(track->GetCreatorProcess());
+		clone->SetProperTime(track->GetProperTime());
+
+		auto info = parentInfo ? new TrackInformation(*parentInfo) : new TrackInformation();
+		info->SetSplitClone(true);
+		info->SetRouletteKilled(false);
+		clone->SetUserInformation(info);
+
+		secondaries->push_back(clone);
+	}
+
+	return false;
+}
+
+// ============================================================================
+// Private Helpers
+// ============================================================================
+
+/**
+ * @brief Returns the number of slabs that fit in the drift region.
+ *
+ * At most /ats/bias/nCells, and no slab thinner than /ats/bias/minCellWidth.
+ * Returns 0 if the geometry has no drift region (no converter stack or D-T
+ * cell) or if it is thinner than the minimum width, which disables biasing;
+ * the latter is reported once.
+ */
+G4int ImportanceSplitting::GetNumberOfSlabs() const
+{
+	G4double gap = fDetectorConstruction->GetDTZStart() - fDetectorConstruction->GetConverterZEnd();
+	if (gap <= 0. || fNumCells < 1)
+		return 0;
+
+	G4int nSlabs = std::min(fNumCells, static_cast<G4int>(gap / fMinCellWidth));
+	if (nSlabs < 1)
+	{
+		static std::once_flag warned;
+		std::call_once(warned, [gap, this]() {
+			G4ExceptionDescription msg;
+			msg << "Drift region of " << gap / mm << " mm is thinner than the minimum slab width of "
+				<< fMinCellWidth / mm << " mm; importance splitting is disabled.";
+			G4Exception("ImportanceSplitting", "DriftTooThin", JustWarning, msg);
+		});
+	}
+	return nSlabs;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the importance cell index of a z position.
+ * @param z Position along the beam axis.
+ * @param nSlabs Number of slabs in the drift region (at least 1).
+ */
+G4int ImportanceSplitting::GetCell(G4double z, G4int nSlabs) const
+{
+	G4double z0 = fDetectorConstruction->GetConverterZEnd();
+	G4double z1 = fDetectorConstruction->GetDTZStart();
+	if (z < z0)
+		return 0;
+	if (z >= z1)
+		return nSlabs + 1;
+
+	G4int cell = 1 + static_cast<G4int>((z - z0) / (z1 - z0) * nSlabs);
+	return std::min(cell, nSlabs);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns true for muons and charged pions.
+ */
+G4bool ImportanceSplitting::IsBiased(const G4ParticleDefinition *particle) const
+{
+	return particle == G4MuonPlus::Definition() || particle == G4MuonMinus::Definition() ||
+		   particle == G4PionPlus::Definition() || particle == G4PionMinus::Definition();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Declares the /ats/bias/ UI commands.
+ */
+void ImportanceSplitting::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/bias/", "Importance splitting toward the D-T cell");
+
+	fMessenger->DeclareProperty("enable", fEnabled, "Enable importance splitting / Russian roulette.");
+
+	auto &cellsCmd = fMessenger->DeclareProperty("nCells", fNumCells,
+												 "Number of importance slabs between the last converter and the D-T cell.");
+	cellsCmd.SetRange("nCells>=1");
+
+	auto &widthCmd = fMessenger->DeclarePropertyWithUnit("minCellWidth", "mm", fMinCellWidth,
+														 "Minimum slab thickness (fewer slabs in a thinner drift region).");
+	widthCmd.SetRange("minCellWidth>0.");
+
+	auto &ratioCmd = fMessenger->DeclareProperty("ratio", fRatio, "Importance ratio between adjacent cells.");
+	ratioCmd.SetRange("ratio>=1.");
+
+	auto &maxCmd = fMessenger->DeclareProperty("maxSplit", fMaxSplit, "Maximum number of copies per crossing.");
+	maxCmd.SetRange("maxSplit>=1");
+}
+// ============================================================================
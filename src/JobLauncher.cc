@@ -0,0 +1,334 @@
+// ============================================================================
+//  File   : JobLauncher.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the multi-process fan-out: fork, seed partitioning,
+//           retry of crashed jobs and merge of the job outputs.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "JobLauncher.hh"
+#include "OutputManager.hh"
+
+#include "G4StateManager.hh"
+#include "G4UImanager.hh"
+#include "G4ios.hh"
+
+#include "TFileMerger.h"
+
+#include <cerrno>
+#include <csignal>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define ATS_JOB_LAUNCHER_FORK
+#endif
+
+namespace
+{
+/// Signal received by the parent (forwarded once to the jobs).
+volatile std::sig_atomic_t gParentSignal = 0;
+
+/// Parent signal handler: records the signal; waitpid() returns with EINTR.
+void HandleParentSignal(int signal)
+{
+	gParentSignal = signal;
+}
+} // namespace
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+/**
+ * @brief Constructor
+ */
+JobLauncher::JobLauncher(G4int nJobs, G4long nEvents, G4long masterSeed, G4int maxRetries)
+	: fNumJobs(nJobs), fNumEvents(nEvents), fMasterSeed(masterSeed), fMaxRetries(maxRetries)
+{
+}
+
+// ============================================================================
+// Parent
+// ============================================================================
+
+/**
+ * @brief Forks the jobs, waits for them and merges their outputs.
+ *
+ * Each job runs in its own process group, so a Ctrl-C on the terminal reaches
+ * only the parent, which forwards it once to every running job (a second
+ * signal would terminate them) and stops restarting crashed jobs.
+ *
+ * @return The job index in a child; -1 in the parent.
+ */
+G4int JobLauncher::Fork()
+{
+#ifdef ATS_JOB_LAUNCHER_FORK
+	struct sigaction action = {};
+	action.sa_handler = &HandleParentSignal;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+
+	std::vector<pid_t> pids(fNumJobs, 0);
+	std::vector<G4int> retries(fNumJobs, 0);
+	std::vector<G4String> outputs(fNumJobs);
+	fReadFds.assign(fNumJobs, -1);
+
+	G4int running = 0;
+	for (G4int job = 0; job < fNumJobs; ++job)
+	{
+		pids[job] = Start(job);
+		if (pids[job] == 0)
+			return fJob;
+		if (pids[job] < 0)
+			fExitCode = 1;
+		running += pids[job] > 0;
+	}
+
+	G4bool forwarded = false;
+	while (running > 0)
+	{
+		int status = 0;
+		pid_t pid = waitpid(-1, &status, 0);
+		if (pid < 0)
+		{
+			if (errno != EINTR)
+				break;
+			if (gParentSignal != 0 && !forwarded)
+			{
+				G4cout << "[Jobs] Signal " << static_cast<G4int>(gParentSignal) << ": stopping all jobs" << G4endl;
+				for (pid_t job : pids)
+				{
+					if (job > 0)
+						kill(job, gParentSignal);
+				}
+				forwarded = true;
+			}
+			continue;
+		}
+
+		G4int job = 0;
+		while (job < fNumJobs && pids[job] != pid)
+			++job;
+		if (job == fNumJobs)
+			continue;
+
+		// The job reports its output file name just before exiting
+		std::string report;
+		char buffer[256];
+		for (ssize_t n; (n = read(fReadFds[job], buffer, sizeof(buffer))) > 0;)
+			report.append(buffer, n);
+		close(fReadFds[job]);
+		fReadFds[job] = -1;
+		pids[job] = 0;
+		--running;
+
+		if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && !report.empty())
+		{
+			outputs[job] = report;
+			G4cout << "[Jobs] Job " << job << " finished: " << report << G4endl;
+			continue;
+		}
+
+		G4cout << "[Jobs] Job " << job << " failed ("
+			   << (WIFSIGNALED(status) ? "signal " + std::to_string(WTERMSIG(status))
+									   : "exit code " + std::to_string(WEXITSTATUS(status)))
+			   << ")" << G4endl;
+
+		if (!forwarded && retries[job] < fMaxRetries)
+		{
+			++retries[job];
+			G4cout << "[Jobs] Restarting job " << job << " (retry " << retries[job] << " of " << fMaxRetries << ")" << G4endl;
+			pids[job] = Start(job);
+			if (pids[job] == 0)
+				return fJob;
+			if (pids[job] < 0)
+				fExitCode = 1;
+			running += pids[job] > 0;
+		}
+		else
+		{
+			fExitCode = 1;
+		}
+	}
+
+	std::vector<G4String> finished;
+	for (const auto &output : outputs)
+	{
+		if (!output.empty())
+			finished.push_back(output);
+	}
+	G4cout << "[Jobs] " << finished.size() << " of " << fNumJobs << " jobs produced output" << G4endl;
+
+	if (!finished.empty() && !Merge(finished))
+	{
+		fExitCode = 1;
+	}
+#else
+	G4cerr << "[Jobs] --jobs needs fork(); not available on this platform" << G4endl;
+	fExitCode = 1;
+#endif
+	return -1;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Starts job k with a pipe for its output report.
+ * @return Process ID in the parent (-1 if fork failed), 0 in the child.
+ */
+G4int JobLauncher::Start(G4int job)
+{
+#ifdef ATS_JOB_LAUNCHER_FORK
+	int fds[2];
+	if (pipe(fds) != 0)
+	{
+		G4cerr << "[Jobs] Cannot create a pipe for job " << job << G4endl;
+		return -1;
+	}
+
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+		G4cerr << "[Jobs] Cannot fork job " << job << G4endl;
+		close(fds[0]);
+		close(fds[1]);
+		return -1;
+	}
+
+	if (pid == 0)
+	{
+		// Child: own process group, default signal handling until RunInterrupt is installed
+		setpgid(0, 0);
+		signal(SIGINT, SIG_DFL);
+		signal(SIGTERM, SIG_DFL);
+		for (G4int fd : fReadFds)
+		{
+			if (fd >= 0)
+				close(fd);
+		}
+		close(fds[0]);
+		fReadFds.clear();
+		fReportFd = fds[1];
+		fJob = job;
+		return 0;
+	}
+
+	close(fds[1]);
+	fReadFds[job] = fds[0];
+	G4cout << "[Jobs] Job " << job << " (pid " << pid << "): " << GetJobEvents(job) << " events, seeds "
+		   << fMasterSeed << " " << job + 1 << G4endl;
+	return pid;
+#else
+	(void)job;
+	return -1;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Merges the job outputs into one file.
+ *
+ * The merged file takes the name of job 0 without its _job0 suffix (or with
+ * _merged appended if the template placed {job} elsewhere). The job files and
+ * their JSON records are kept.
+ *
+ * @param outputs Output files of the finished jobs.
+ */
+G4bool JobLauncher::Merge(const std::vector<G4String> &outputs) const
+{
+	G4String merged = outputs.front();
+	auto suffix = merged.rfind("_job");
+	if (suffix != std::string::npos && merged.find('.', suffix) != std::string::npos)
+	{
+		merged.erase(suffix, merged.find('.', suffix) - suffix);
+	}
+	else
+	{
+		merged.insert(merged.rfind('.'), "_merged");
+	}
+
+	TFileMerger merger(false);
+	merger.SetPrintLevel(0);
+	if (!merger.OutputFile(merged.c_str(), "RECREATE"))
+	{
+		G4cerr << "[Jobs] Cannot write " << merged << G4endl;
+		return false;
+	}
+	for (const auto &output : outputs)
+	{
+		merger.AddFile(output.c_str(), false);
+	}
+
+	G4bool ok = merger.Merge();
+	G4cout << "[Jobs] " << (ok ? "Merged " : "Failed to merge ") << outputs.size() << " job outputs into " << merged
+		   << G4endl;
+	return ok;
+}
+
+// ============================================================================
+// Child
+// ============================================================================
+
+/**
+ * @brief Configures and runs the events of this job, then reports its output.
+ * @param uiManager UI manager of the child.
+ * @param macro Setup macro executed first (may be empty).
+ */
+void JobLauncher::RunJob(G4UImanager *uiManager, const G4String &macro)
+{
+	if (!macro.empty())
+	{
+		uiManager->ApplyCommand("/control/execute " + macro);
+	}
+
+	// One output per job: <template>_job<k>, unless the template places {job} itself
+	G4String name = uiManager->GetCurrentValues("/ats/output/name");
+	if (name.find("{job}") == std::string::npos)
+	{
+		name += "_job{job}";
+	}
+	uiManager->ApplyCommand("/ats/output/name " + name);
+	uiManager->ApplyCommand("/ats/output/job " + std::to_string(fJob));
+
+	// MixMax: distinct seed tuples give non-overlapping streams
+	uiManager->ApplyCommand("/random/setSeeds " + std::to_string(fMasterSeed) + " " + std::to_string(fJob + 1));
+
+	// Global event numbering: every job draws its own range of beam samples and,
+	// with /ats/seed/perEvent, of event seeds (one global sequence, independent of N)
+	G4long offset = 0;
+	for (G4int job = 0; job < fJob; ++job)
+	{
+		offset += GetJobEvents(job);
+	}
+	uiManager->ApplyCommand("/ats/seed/master " + std::to_string(fMasterSeed));
+	uiManager->ApplyCommand("/ats/seed/eventOffset " + std::to_string(offset));
+
+	if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_PreInit)
+	{
+		uiManager->ApplyCommand("/run/initialize");
+	}
+	uiManager->ApplyCommand("/run/beamOn " + std::to_string(GetJobEvents(fJob)));
+
+#ifdef ATS_JOB_LAUNCHER_FORK
+	std::string report = OutputManager::Instance()->GetOutputName() + ".root";
+	ssize_t written = write(fReportFd, report.data(), report.size());
+	(void)written;
+	close(fReportFd);
+	fReportFd = -1;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Number of events of job k (the remainder goes to the first jobs).
+ */
+G4long JobLauncher::GetJobEvents(G4int job) const
+{
+	return fNumEvents / fNumJobs + (job < fNumEvents % fNumJobs ? 1 : 0);
+}
+// ============================================================================
@@ -0,0 +1,189 @@
+// ============================================================================
+//  File   : KeptEventManager.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the reservoir sampling of events kept for
+//           visualization, with optional priority for D-T muon stops.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "KeptEventManager.hh"
+#include "Run.hh"
+
+#include "G4Event.hh"
+#include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Constructor
+ *
+ * Defaults: at most 100 events per run (the default number of events the
+ * visualization accumulates), D-T stops preferred.
+ */
+KeptEventManager::KeptEventManager()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ *
+ * The kept events belong to the run and are deleted with it.
+ */
+KeptEventManager::~KeptEventManager()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Reservoir Sampling
+// ============================================================================
+
+/**
+ * @brief Decides whether the current event is kept.
+ *
+ * Priority events (D-T stops, if preferred) first replace ordinary events and,
+ * once the reservoir holds only priority events, are reservoir-sampled among
+ * themselves. Ordinary events are reservoir-sampled into the ordinary slots.
+ *
+ * @param event Event being finished.
+ * @param muonStopInDT True if a muon stopped in the D-T gas in this event.
+ * @return True if the caller should keep the event.
+ */
+G4bool KeptEventManager::Offer(const G4Event *event, G4bool muonStopInDT)
+{
+	if (fMaxEvents <= 0)
+		return true;
+
+	CheckRun();
+
+	// Events replaced at an earlier end of event are no longer referenced
+	auto run = dynamic_cast<Run *>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+	if (run)
+	{
+		run->DeleteReleasedEvents();
+	}
+
+	G4bool priority = fPreferDT && muonStopInDT;
+	G4long &offered = priority ? fNumOfferedDT : fNumOffered;
+	++offered;
+
+	if (static_cast<G4int>(fSlots.size()) < fMaxEvents)
+	{
+		fSlots.push_back({event, priority});
+		return true;
+	}
+
+	G4int slot = -1;
+	if (priority)
+	{
+		slot = PickSlot(false);
+		if (slot < 0)
+		{
+			// Reservoir holds only priority events: Algorithm R among them
+			G4long j = Draw(offered);
+			if (j >= fMaxEvents)
+				return false;
+			slot = static_cast<G4int>(j);
+		}
+	}
+	else
+	{
+		G4long nOrdinary = 0;
+		for (const auto &s : fSlots)
+			nOrdinary += s.priority ? 0 : 1;
+
+		if (nOrdinary == 0 || Draw(offered) >= nOrdinary)
+			return false;
+		slot = PickSlot(false);
+	}
+
+	Replace(slot, event, priority);
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Clears the reservoir and reseeds the generator when a new run has started.
+ *
+ * The events of the previous run were deleted with it. Seeding from the run and
+ * thread IDs makes the selection reproducible for a given event sequence.
+ */
+void KeptEventManager::CheckRun()
+{
+	const G4Run *run = G4RunManager::GetRunManager()->GetCurrentRun();
+	G4int runID = run ? run->GetRunID() : 0;
+	if (runID == fRunID)
+		return;
+
+	fRunID = runID;
+	fSlots.clear();
+	fNumOffered = 0;
+	fNumOfferedDT = 0;
+	fEngine.seed(1000003ULL * static_cast<unsigned long long>(runID) + G4Threading::G4GetThreadId() + 1);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the index of a random slot with the given priority (-1 if none).
+ */
+G4int KeptEventManager::PickSlot(G4bool priority)
+{
+	std::vector<G4int> candidates;
+	for (G4int i = 0; i < static_cast<G4int>(fSlots.size()); ++i)
+	{
+		if (fSlots[i].priority == priority)
+			candidates.push_back(i);
+	}
+
+	if (candidates.empty())
+		return -1;
+	return candidates[Draw(static_cast<G4long>(candidates.size()))];
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Releases the event held in a slot and stores the new one.
+ *
+ * The replaced event was stored by the run manager at the end of its event;
+ * it is removed from the Run, which deletes it together with its trajectories
+ * once neither the run manager nor the vis manager refers to it.
+ */
+void KeptEventManager::Replace(G4int slot, const G4Event *event, G4bool priority)
+{
+	auto run = dynamic_cast<Run *>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+	if (run)
+	{
+		run->ReleaseEvent(fSlots[slot].event);
+	}
+
+	fSlots[slot] = {event, priority};
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/keep/ UI commands.
+ */
+void KeptEventManager::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/keep/", "Bounded retention of muon events for visualization");
+
+	auto &maxCmd = fMessenger->DeclareProperty("maxEvents", fMaxEvents,
+											   "Muon events kept per run and thread, sampled uniformly (0: keep all).");
+	maxCmd.SetRange("maxEvents>=0");
+
+	fMessenger->DeclareProperty("preferDT", fPreferDT,
+								"Prefer events with a muon stop in the D-T gas over other muon events.");
+}
+// ============================================================================
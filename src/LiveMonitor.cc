@@ -0,0 +1,380 @@
+// ============================================================================
+//  File   : LiveMonitor.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the live monitor (double-buffered per-thread snapshots
+//           merged on demand and served as JSON on a Unix-domain socket).
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "LiveMonitor.hh"
+#include "OutputManager.hh"
+#include "RunAction.hh"
+
+#include "G4AutoDelete.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define ATS_LIVE_MONITOR_SOCKETS
+#endif
+
+SnapshotSlots LiveMonitor::fSlots;
+std::atomic<G4long> LiveMonitor::fEventsDone{0};
+std::atomic<G4long> LiveMonitor::fRequested{0};
+std::atomic<G4bool> LiveMonitor::fStop{false};
+std::atomic<G4int> LiveMonitor::fRunID{0};
+std::atomic<G4double> LiveMonitor::fStartTime{0.};
+
+namespace
+{
+/// Seconds on the steady clock.
+G4double Now()
+{
+	return std::chrono::duration<G4double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the instance of the calling thread, deleted at thread exit.
+ */
+LiveMonitor *LiveMonitor::Instance()
+{
+	static G4ThreadLocal LiveMonitor *instance = nullptr;
+	if (!instance)
+	{
+		instance = new LiveMonitor();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ */
+LiveMonitor::LiveMonitor()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+LiveMonitor::~LiveMonitor()
+{
+	if (fServer.joinable())
+	{
+		fStop = true;
+		fServer.join();
+	}
+	delete fMessenger;
+}
+
+// ============================================================================
+// Run Lifecycle
+// ============================================================================
+
+/**
+ * @brief Starts the server (master) and registers the slot of a processing thread.
+ *
+ * The master begins the run before the workers: it resets the shared state,
+ * binds the socket (replacing a stale one left by a killed job) and starts
+ * the server thread.
+ *
+ * @param runID ID of the new run.
+ * @param master True on the master (or sequential) thread.
+ * @param processing True on threads that process events.
+ */
+void LiveMonitor::BeginOfRun(G4int runID, G4bool master, G4bool processing)
+{
+	if (!fEnabled)
+		return;
+
+	if (master)
+	{
+		fSlots.Clear();
+		fEventsDone = 0;
+		fRequested = 1;
+		fStop = false;
+		fRunID = runID;
+		fStartTime = Now();
+
+#ifdef ATS_LIVE_MONITOR_SOCKETS
+		sockaddr_un address = {};
+		address.sun_family = AF_UNIX;
+		if (fSocketPath.size() >= sizeof(address.sun_path))
+		{
+			G4cerr << "[Monitor] Socket path too long: " << fSocketPath << G4endl;
+		}
+		else
+		{
+			std::strncpy(address.sun_path, fSocketPath.c_str(), sizeof(address.sun_path) - 1);
+			unlink(fSocketPath.c_str());
+
+			int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+			if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+				listen(listenFd, 4) != 0)
+			{
+				G4cerr << "[Monitor] Cannot listen on " << fSocketPath << ": " << std::strerror(errno) << G4endl;
+				if (listenFd >= 0)
+					close(listenFd);
+			}
+			else
+			{
+				fBoundPath = fSocketPath;
+				fServer = std::thread(&LiveMonitor::ServerLoop, this, listenFd, fInterval);
+				G4cout << "[Monitor] Serving run " << runID << " on " << fSocketPath << G4endl;
+			}
+		}
+#else
+		G4cerr << "[Monitor] Live monitoring needs Unix-domain sockets; disabled on this platform" << G4endl;
+#endif
+	}
+
+	if (processing)
+	{
+		fSlot = std::make_unique<SnapshotSlot>();
+		fPublished = 0;
+		fNumEvents = 0;
+		fSlots.Add(fSlot.get());
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Counts a finished event and publishes a snapshot if one is requested.
+ * @param runAction Run action of the calling thread.
+ */
+void LiveMonitor::EndOfEvent(const RunAction *runAction)
+{
+	if (!fSlot)
+		return;
+
+	++fNumEvents;
+	++fEventsDone;
+
+	G4long requested = fRequested;
+	if (requested > fPublished)
+	{
+		Publish(runAction, requested);
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Withdraws the slot of this thread; the master stops the server.
+ *
+ * The master's end of run comes after all workers, so the socket stays
+ * available until the run is complete.
+ *
+ * @param master True on the master (or sequential) thread.
+ */
+void LiveMonitor::EndOfRun(G4bool master)
+{
+	if (fSlot)
+	{
+		fSlots.Remove(fSlot.get());
+	}
+
+	if (master && fServer.joinable())
+	{
+		fStop = true;
+		fServer.join();
+	}
+
+	fSlot.reset();
+}
+
+// ============================================================================
+// Snapshots
+// ============================================================================
+
+/**
+ * @brief Fills the back buffer of this thread and swaps it to the front.
+ *
+ * If a client is being served from the front buffer right now, the try-lock
+ * fails and the snapshot is published again at the end of the next event.
+ *
+ * @param runAction Run action of this thread (source of the counters).
+ * @param generation Snapshot generation being answered.
+ */
+void LiveMonitor::Publish(const RunAction *runAction, G4long generation)
+{
+	RunSnapshot &snapshot = fSlot->Back();
+	snapshot.Capture(runAction, false);
+	snapshot.threadID = G4Threading::G4GetThreadId();
+	snapshot.generation = generation;
+	snapshot.events = fNumEvents;
+
+	if (fSlot->Swap())
+		fPublished = generation;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Merges the front buffers of all threads into one JSON document.
+ *
+ * Layout: run, elapsed (s), events, eventsPerSecond, threads (id, events,
+ * generation), counters (name: value) and histograms (name, nBins, xMin,
+ * xMax, entries, underflow, overflow, bins).
+ */
+std::string LiveMonitor::BuildJson() const
+{
+	RunSnapshot merged;
+	std::vector<RunSnapshot> threads;
+	fSlots.ForEachFront([&](const RunSnapshot &front) {
+		RunSnapshot thread;
+		thread.threadID = front.threadID;
+		thread.generation = front.generation;
+		thread.events = front.events;
+		threads.push_back(thread);
+
+		merged.Add(front);
+	});
+
+	G4long events = fEventsDone;
+	G4double elapsed = Now() - fStartTime;
+
+	std::ostringstream json;
+	json.precision(10);
+	json << "{\"run\":" << fRunID << ",\"elapsed\":" << elapsed << ",\"events\":" << events
+		 << ",\"eventsPerSecond\":" << (elapsed > 0. ? events / elapsed : 0.);
+
+	json << ",\"threads\":[";
+	for (std::size_t i = 0; i < threads.size(); ++i)
+	{
+		json << (i ? "," : "") << "{\"id\":" << threads[i].threadID << ",\"events\":" << threads[i].events
+			 << ",\"generation\":" << threads[i].generation << "}";
+	}
+
+	json << "],\"counters\":{";
+	G4bool first = true;
+	for (const auto &[name, value] : merged.counters)
+	{
+		json << (first ? "" : ",") << OutputManager::Quote(name) << ":" << value;
+		first = false;
+	}
+
+	json << "},\"histograms\":[";
+	first = true;
+	for (const RunSnapshot::Histogram &h : merged.histograms)
+	{
+		if (h.nBins == 0 || h.sumW.size() < static_cast<std::size_t>(h.nBins) + 2)
+			continue;
+
+		json << (first ? "" : ",") << "{\"name\":" << OutputManager::Quote(h.name) << ",\"nBins\":" << h.nBins
+			 << ",\"xMin\":" << h.xMin << ",\"xMax\":" << h.xMax << ",\"entries\":" << h.entries
+			 << ",\"underflow\":" << h.sumW[0] << ",\"overflow\":" << h.sumW[h.nBins + 1] << ",\"bins\":[";
+		for (G4int b = 1; b <= h.nBins; ++b)
+		{
+			json << (b > 1 ? "," : "") << h.sumW[b];
+		}
+		json << "]}";
+		first = false;
+	}
+	json << "]}\n";
+
+	return json.str();
+}
+
+// ============================================================================
+// Server
+// ============================================================================
+
+/**
+ * @brief Server thread: requests snapshots periodically and answers clients.
+ *
+ * Each accepted connection gets one JSON document and is closed. The
+ * listening socket is polled with a short timeout, so the thread notices the
+ * end of the run quickly; the socket file is removed when it stops.
+ *
+ * @param listenFd Bound and listening socket.
+ * @param interval Seconds between snapshot requests.
+ */
+void LiveMonitor::ServerLoop(int listenFd, G4double interval)
+{
+#ifdef ATS_LIVE_MONITOR_SOCKETS
+	G4double lastRequest = Now();
+
+	while (!fStop)
+	{
+		pollfd listener = {listenFd, POLLIN, 0};
+		int ready = poll(&listener, 1, 200);
+
+		if (Now() - lastRequest >= interval)
+		{
+			++fRequested;
+			lastRequest = Now();
+		}
+
+		if (ready <= 0 || !(listener.revents & POLLIN))
+			continue;
+
+		int client = accept(listenFd, nullptr, nullptr);
+		if (client < 0)
+			continue;
+
+		std::string json = BuildJson();
+		int flags = 0;
+#ifdef MSG_NOSIGNAL
+		flags = MSG_NOSIGNAL; // a client that hangs up must not kill the job
+#endif
+		std::size_t sent = 0;
+		while (sent < json.size())
+		{
+			ssize_t n = send(client, json.data() + sent, json.size() - sent, flags);
+			if (n <= 0)
+				break;
+			sent += static_cast<std::size_t>(n);
+		}
+		close(client);
+	}
+
+	close(listenFd);
+	unlink(fBoundPath.c_str());
+#else
+	(void)listenFd;
+	(void)interval;
+#endif
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/monitor/ UI commands.
+ */
+void LiveMonitor::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/monitor/", "Live run monitoring");
+
+	fMessenger->DeclareProperty("enable", fEnabled,
+								"Serve live histograms and counters as JSON on a Unix-domain socket.");
+
+	fMessenger->DeclareProperty("socket", fSocketPath,
+								"Path of the Unix-domain socket (replaced if it exists).");
+
+	auto &intervalCmd = fMessenger->DeclareProperty("interval", fInterval,
+													"Seconds between snapshot updates.");
+	intervalCmd.SetRange("interval>0.");
+}
+// ============================================================================
@@ -0,0 +1,131 @@
+// ============================================================================
+//  File   : LooperControl.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the looper thresholds of the transportation processes
+//           and of the field propagator.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "LooperControl.hh"
+
+#include "G4AutoDelete.hh"
+#include "G4GenericMessenger.hh"
+#include "G4ParticleTable.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4PropagatorInField.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Transportation.hh"
+#include "G4TransportationManager.hh"
+#include "G4ios.hh"
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the instance of the calling thread, deleted at thread exit.
+ */
+LooperControl *LooperControl::Instance()
+{
+	static G4ThreadLocal LooperControl *instance = nullptr;
+	if (!instance)
+	{
+		instance = new LooperControl();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ */
+LooperControl::LooperControl()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+LooperControl::~LooperControl()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Thresholds
+// ============================================================================
+
+/**
+ * @brief Pushes the configured thresholds into this thread's transportation.
+ *
+ * Physics lists share one G4Transportation (or G4CoupledTransportation) per
+ * thread between particles, so each distinct process is configured once.
+ */
+void LooperControl::ApplyThresholds()
+{
+	if (fMaxLoopCount > 0)
+	{
+		G4TransportationManager::GetTransportationManager()->GetPropagatorInField()->SetMaxLoopCount(fMaxLoopCount);
+	}
+
+	if (fWarningEnergy < 0. && fImportantEnergy < 0. && fNumberOfTrials < 0)
+		return;
+
+	G4Transportation *previous = nullptr;
+	auto iterator = G4ParticleTable::GetParticleTable()->GetIterator();
+	iterator->reset();
+	while ((*iterator)())
+	{
+		G4ProcessManager *processManager = iterator->value()->GetProcessManager();
+		if (!processManager)
+			continue;
+
+		G4ProcessVector *processes = processManager->GetProcessList();
+		for (size_t i = 0; i < processes->size(); ++i)
+		{
+			auto transportation = dynamic_cast<G4Transportation *>((*processes)[i]);
+			if (!transportation || transportation == previous)
+				continue;
+
+			if (fWarningEnergy >= 0.)
+				transportation->SetThresholdWarningEnergy(fWarningEnergy);
+			if (fImportantEnergy >= 0.)
+				transportation->SetThresholdImportantEnergy(fImportantEnergy);
+			if (fNumberOfTrials >= 0)
+				transportation->SetThresholdTrials(fNumberOfTrials);
+			previous = transportation;
+		}
+	}
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/looper/ UI commands.
+ */
+void LooperControl::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/looper/", "Looping-particle thresholds in magnetic fields");
+
+	fMessenger->DeclarePropertyWithUnit("warningEnergy", "MeV", fWarningEnergy,
+										"Loopers below this energy are killed silently (negative: Geant4 default).");
+
+	fMessenger->DeclarePropertyWithUnit("importantEnergy", "MeV", fImportantEnergy,
+										"Loopers above this energy get numberOfTrials steps (negative: Geant4 default).");
+
+	fMessenger->DeclareProperty("numberOfTrials", fNumberOfTrials,
+								"Looping steps tolerated for important loopers (negative: Geant4 default).");
+
+	fMessenger->DeclareProperty("maxLoopCount", fMaxLoopCount,
+								"Chord-integration loops per step in G4PropagatorInField (negative: Geant4 default).");
+}
+// ============================================================================
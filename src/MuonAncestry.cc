@@ -0,0 +1,44 @@
+// ============================================================================
+//  File   : MuonAncestry.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the shared test for muons and their possible ancestors.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "MuonAncestry.hh"
+
+#include "G4KaonMinus.hh"
+#include "G4KaonPlus.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4PionMinus.hh"
+#include "G4PionPlus.hh"
+#include "G4PionZero.hh"
+
+// ============================================================================
+// Muon Chain
+// ============================================================================
+
+/**
+ * @brief Returns true for muons and for particles that may decay into one.
+ */
+G4bool MuonAncestry::IsMuonAncestor(const G4ParticleDefinition *particle)
+{
+	if (particle == G4PionPlus::Definition() || particle == G4PionMinus::Definition() ||
+		particle == G4KaonPlus::Definition() || particle == G4KaonMinus::Definition() ||
+		particle == G4MuonPlus::Definition() || particle == G4MuonMinus::Definition())
+	{
+		return true;
+	}
+
+	const G4String &type = particle->GetParticleType();
+	if (type == "meson" && particle != G4PionZero::Definition())
+		return true;
+
+	return type == "baryon" && (particle->GetQuarkContent(3) > 0 || particle->GetAntiQuarkContent(3) > 0);
+}
+// ============================================================================
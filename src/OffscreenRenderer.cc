@@ -0,0 +1,261 @@
+// ============================================================================
+//  File   : OffscreenRenderer.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements headless rendering of the geometry and of the top-N
+//           kept muon events to image files.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "OffscreenRenderer.hh"
+
+#include "G4AutoDelete.hh"
+#include "G4Event.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Run.hh"
+#include "G4StateManager.hh"
+#include "G4TrajectoryContainer.hh"
+#include "G4UImanager.hh"
+#include "G4VStateDependent.hh"
+#include "G4VTrajectory.hh"
+#include "G4VisManager.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// End-of-Run Hook
+// ============================================================================
+
+/**
+ * @class OffscreenRenderer::EndOfRunHook
+ * @brief Renders the scheduled run when the run manager returns to Idle.
+ *
+ * State dependents are notified in the order of registration. The hook is
+ * registered at the end of the first run, after the vis manager's own
+ * dependent, so the pictures follow the vis manager's end-of-run redraw.
+ */
+class OffscreenRenderer::EndOfRunHook : public G4VStateDependent
+{
+  public:
+	explicit EndOfRunHook(OffscreenRenderer *renderer) : fRenderer(renderer) {}
+
+	G4bool Notify(G4ApplicationState requestedState) override
+	{
+		G4ApplicationState previousState = G4StateManager::GetStateManager()->GetPreviousState();
+		if (previousState == G4State_GeomClosed && requestedState == G4State_Idle)
+		{
+			fRenderer->RenderScheduledRun();
+		}
+		return true;
+	}
+
+  private:
+	OffscreenRenderer *fRenderer;
+};
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the renderer of the calling thread, deleted at thread exit.
+ */
+OffscreenRenderer *OffscreenRenderer::Instance()
+{
+	static G4ThreadLocal OffscreenRenderer *instance = nullptr;
+	if (!instance)
+	{
+		instance = new OffscreenRenderer();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ */
+OffscreenRenderer::OffscreenRenderer()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+OffscreenRenderer::~OffscreenRenderer()
+{
+	delete fEndOfRunHook;
+	delete fMessenger;
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+/**
+ * @brief Schedules the top-N kept events of a finished run.
+ *
+ * The master EndOfRunAction() runs before the vis manager's end of run, whose
+ * redraw would otherwise overwrite the last picture; the rendering therefore
+ * waits for the transition to Idle (EndOfRunHook). The run is deleted only at
+ * the start of the next run, so it is still valid then.
+ *
+ * @param run Merged run holding the kept events.
+ */
+void OffscreenRenderer::RenderTopEvents(const G4Run *run)
+{
+	if (fNumEvents <= 0 || !run)
+		return;
+
+	fScheduledRun = run;
+	if (!fEndOfRunHook)
+	{
+		fEndOfRunHook = new EndOfRunHook(this);
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Renders the top-N kept events of the scheduled run.
+ *
+ * Events are ranked by the number of muon trajectories, then by the total
+ * number of trajectories. Each one is handed to the visualization manager as
+ * the requested event (as /vis/reviewKeptEvents does) and drawn to its own
+ * file.
+ */
+void OffscreenRenderer::RenderScheduledRun()
+{
+	const G4Run *run = fScheduledRun;
+	fScheduledRun = nullptr;
+	if (!run || !IsVisActive())
+		return;
+
+	const std::vector<const G4Event *> *events = run->GetEventVector();
+	if (!events || events->empty())
+	{
+		G4cout << "[Render] No kept events in run " << run->GetRunID()
+			   << " (check /ats/keep/maxEvents and the muon event selection)" << G4endl;
+		return;
+	}
+
+	// (muon trajectories, all trajectories) per kept event
+	std::vector<std::pair<std::pair<G4int, G4int>, const G4Event *>> ranked;
+	for (const G4Event *event : *events)
+	{
+		G4TrajectoryContainer *trajectories = event->GetTrajectoryContainer();
+		if (!trajectories)
+			continue;
+
+		G4int nMuons = 0;
+		G4int nTrajectories = static_cast<G4int>(trajectories->entries());
+		for (G4int i = 0; i < nTrajectories; ++i)
+		{
+			G4int pdg = (*trajectories)[i]->GetPDGEncoding();
+			if (pdg == 13 || pdg == -13)
+				++nMuons;
+		}
+		ranked.push_back({{nMuons, nTrajectories}, event});
+	}
+
+	G4int n = std::min<G4int>(fNumEvents, static_cast<G4int>(ranked.size()));
+	std::partial_sort(ranked.begin(), ranked.begin() + n, ranked.end(),
+					  [](const auto &a, const auto &b) { return a.first > b.first; });
+
+	auto visManager = static_cast<G4VisManager *>(G4VVisManager::GetConcreteInstance());
+	for (G4int i = 0; i < n; ++i)
+	{
+		const G4Event *event = ranked[i].second;
+		G4String fileName = fPrefix + "_r" + std::to_string(run->GetRunID()) +
+							"_e" + std::to_string(event->GetEventID()) + "." + fFormat;
+
+		visManager->SetRequestedEvent(event);
+		RenderToFile(fileName);
+
+		G4cout << "[Render] Event " << event->GetEventID()
+			   << " | Muon trajectories: " << ranked[i].first.first
+			   << " | Trajectories: " << ranked[i].first.second
+			   << " | " << fileName << G4endl;
+	}
+	visManager->SetRequestedEvent(nullptr);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Renders the current scene (normally the bare geometry) to a file.
+ */
+void OffscreenRenderer::RenderGeometry(const G4String &fileName)
+{
+	if (!IsVisActive())
+		return;
+
+	RenderToFile(fileName);
+	G4cout << "[Render] Geometry | " << fileName << G4endl;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Points the offscreen viewer at a file and rebuilds the view.
+ *
+ * Every later redraw writes the driver's current file, so it is pointed at
+ * <prefix>_view.<format> afterwards to keep the picture intact.
+ */
+void OffscreenRenderer::RenderToFile(const G4String &fileName)
+{
+	auto UImanager = G4UImanager::GetUIpointer();
+	UImanager->ApplyCommand("/vis/tsg/offscreen/set/file " + fileName);
+	UImanager->ApplyCommand("/vis/viewer/rebuild");
+	UImanager->ApplyCommand("/vis/tsg/offscreen/set/file " + fPrefix + "_view." + fFormat);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns true if a visualization manager with a current viewer is active.
+ */
+G4bool OffscreenRenderer::IsVisActive() const
+{
+	if (G4VVisManager::GetConcreteInstance())
+		return true;
+
+	G4Exception("OffscreenRenderer", "NoViewer", JustWarning,
+				"No active visualization (execute vis_offscreen.mac first); nothing rendered.");
+	return false;
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/render/ UI commands (master only).
+ */
+void OffscreenRenderer::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/render/", "Headless rendering to image files");
+
+	auto &geometryCmd = fMessenger->DeclareMethod("geometry", &OffscreenRenderer::RenderGeometry,
+												  "Render the current scene to the given file.");
+	geometryCmd.SetParameterName("file", false);
+	geometryCmd.SetToBeBroadcasted(false);
+
+	auto &eventsCmd = fMessenger->DeclareProperty("events", fNumEvents,
+												  "Render this many kept muon events at the end of each run (0: none).");
+	eventsCmd.SetRange("events>=0");
+	eventsCmd.SetToBeBroadcasted(false);
+
+	auto &prefixCmd = fMessenger->DeclareProperty("prefix", fPrefix,
+												  "File name prefix of the event pictures (_r<run>_e<event> is appended).");
+	prefixCmd.SetToBeBroadcasted(false);
+
+	auto &formatCmd = fMessenger->DeclareProperty("format", fFormat,
+												  "Image format of the event pictures.");
+	formatCmd.SetCandidates("png jpg eps ps pdf svg");
+	formatCmd.SetToBeBroadcasted(false);
+}
+// ============================================================================
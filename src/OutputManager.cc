@@ -0,0 +1,326 @@
+// ============================================================================
+//  File   : OutputManager.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the output name templates and the JSON run sidecar.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "OutputManager.hh"
+#include "DetectorConstruction.hh"
+#include "RunInterrupt.hh"
+
+#include "G4AnalysisManager.hh"
+#include "G4AutoDelete.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+#include "G4UImanager.hh"
+#include "G4Version.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+
+#ifndef ATS_GIT_HASH
+#define ATS_GIT_HASH "unknown"
+#endif
+
+G4String OutputManager::fResolvedName = "muon_output";
+
+namespace
+{
+/// Formats a wall-clock time as local time with the given strftime format.
+std::string FormatTime(std::chrono::system_clock::time_point time, const char *format)
+{
+	std::time_t t = std::chrono::system_clock::to_time_t(time);
+	std::tm local = {};
+	localtime_r(&t, &local);
+	char buffer[32];
+	std::strftime(buffer, sizeof(buffer), format, &local);
+	return buffer;
+}
+
+/// Replaces every occurrence of a token.
+void ReplaceAll(G4String &text, const std::string &token, const std::string &value)
+{
+	for (std::size_t pos = text.find(token); pos != std::string::npos; pos = text.find(token, pos + value.size()))
+	{
+		text.replace(pos, token.size(), value);
+	}
+}
+} // namespace
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the instance of the calling thread, deleted at thread exit.
+ */
+OutputManager *OutputManager::Instance()
+{
+	static G4ThreadLocal OutputManager *instance = nullptr;
+	if (!instance)
+	{
+		instance = new OutputManager();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ *
+ * Extends the UI command history (20 commands by default) so the sidecar can
+ * list the whole configuration of the session.
+ */
+OutputManager::OutputManager()
+{
+	DefineCommands();
+	G4UImanager::GetUIpointer()->SetMaxHistSize(10000);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+OutputManager::~OutputManager()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Output Names
+// ============================================================================
+
+/**
+ * @brief Resolves the output name of a new run and returns it.
+ *
+ * The master (which begins the run before the workers) records the seed and
+ * start time and resolves the template; the workers reuse its result.
+ *
+ * @param run The run being started.
+ * @param master True on the master (or sequential) thread.
+ * @return Output file name without extension.
+ */
+G4String OutputManager::BeginOfRun(const G4Run *run, G4bool master)
+{
+	if (!master)
+		return fResolvedName;
+
+	fSeed = G4Random::getTheSeed();
+	fStartClock = std::chrono::system_clock::now();
+	fStartTime = std::chrono::steady_clock::now();
+	fResolvedName = Resolve(run);
+
+	G4cout << "[Output] Run " << run->GetRunID() << " writes " << fResolvedName << ".root" << G4endl;
+	if (run->GetRunID() > 0 && fTemplate.find("{run}") == std::string::npos &&
+		fTemplate.find("{timestamp}") == std::string::npos)
+	{
+		G4cout << "[Output] The output of the previous run is overwritten (add {run} to /ats/output/name)" << G4endl;
+	}
+
+	return fResolvedName;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Substitutes the tokens of the template for a run.
+ * @param run The run being started.
+ */
+G4String OutputManager::Resolve(const G4Run *run) const
+{
+	auto detector = static_cast<const DetectorConstruction *>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+	G4String name = fTemplate;
+	ReplaceAll(name, "{run}", std::to_string(run->GetRunID()));
+	ReplaceAll(name, "{job}", std::to_string(fJob));
+	ReplaceAll(name, "{geometry}", detector ? detector->GetDetectorType() : G4String("unknown"));
+	ReplaceAll(name, "{seed}", std::to_string(fSeed));
+	ReplaceAll(name, "{timestamp}", FormatTime(fStartClock, "%Y%m%d-%H%M%S"));
+	return name;
+}
+
+// ============================================================================
+// JSON Sidecar
+// ============================================================================
+
+/**
+ * @brief Writes <name>.json describing the finished run.
+ *
+ * Layout: output, template, run, job, configuration (geometry, seed, threads,
+ * geant4, gitHash, commands), events (requested, completed, resumed,
+ * interruptedBySignal), timing (start, end, wallSeconds, eventsPerSecond),
+ * counters and histograms (name, nBins, xMin, xMax).
+ *
+ * @param run The completed (merged) run.
+ * @param nEvents Completed events, including events resumed from a checkpoint.
+ * @param counters Merged run counters.
+ */
+void OutputManager::WriteSidecar(const G4Run *run, G4long nEvents, const std::map<G4String, G4double> &counters) const
+{
+	if (!fSidecar)
+		return;
+
+	G4String fileName = fResolvedName + ".json";
+	std::ofstream out(fileName);
+	if (!out)
+	{
+		G4cerr << "[Output] Cannot write " << fileName << G4endl;
+		return;
+	}
+
+	auto endClock = std::chrono::system_clock::now();
+	G4double seconds = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fStartTime).count();
+	G4int threads = G4Threading::IsMultithreadedApplication() ? G4Threading::GetNumberOfRunningWorkerThreads() : 1;
+	auto detector = static_cast<const DetectorConstruction *>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+	out.precision(10);
+	out << "{\n"
+		<< "  \"output\": " << Quote(fResolvedName + ".root") << ",\n"
+		<< "  \"template\": " << Quote(fTemplate) << ",\n"
+		<< "  \"run\": " << run->GetRunID() << ",\n"
+		<< "  \"job\": " << fJob << ",\n";
+
+	out << "  \"configuration\": {\n"
+		<< "    \"geometry\": " << Quote(detector ? detector->GetDetectorType() : G4String("unknown")) << ",\n"
+		<< "    \"seed\": " << fSeed << ",\n"
+		<< "    \"threads\": " << threads << ",\n"
+		<< "    \"geant4\": " << G4VERSION_NUMBER << ",\n"
+		<< "    \"gitHash\": " << Quote(ATS_GIT_HASH) << ",\n"
+		<< "    \"commands\": [";
+	auto uiManager = G4UImanager::GetUIpointer();
+	for (G4int i = 0; i < uiManager->GetNumberOfHistory(); ++i)
+	{
+		out << (i ? ", " : "") << Quote(uiManager->GetPreviousCommand(i));
+	}
+	out << "]\n  },\n";
+
+	out << "  \"events\": {\n"
+		<< "    \"requested\": " << run->GetNumberOfEventToBeProcessed() << ",\n"
+		<< "    \"completed\": " << nEvents << ",\n"
+		<< "    \"resumed\": " << nEvents - run->GetNumberOfEvent() << ",\n"
+		<< "    \"interruptedBySignal\": " << RunInterrupt::GetSignal() << "\n"
+		<< "  },\n";
+
+	out << "  \"timing\": {\n"
+		<< "    \"start\": " << Quote(FormatTime(fStartClock, "%Y-%m-%dT%H:%M:%S%z")) << ",\n"
+		<< "    \"end\": " << Quote(FormatTime(endClock, "%Y-%m-%dT%H:%M:%S%z")) << ",\n"
+		<< "    \"wallSeconds\": " << seconds << ",\n"
+		<< "    \"eventsPerSecond\": " << (seconds > 0. ? run->GetNumberOfEvent() / seconds : 0.) << "\n"
+		<< "  },\n";
+
+	out << "  \"counters\": {";
+	G4bool first = true;
+	for (const auto &[name, value] : counters)
+	{
+		out << (first ? "\n" : ",\n") << "    " << Quote(name) << ": " << value;
+		first = false;
+	}
+	out << "\n  },\n";
+
+	out << "  \"histograms\": [";
+	auto analysisManager = G4AnalysisManager::Instance();
+	G4int firstID = analysisManager->GetFirstH1Id();
+	first = true;
+	for (G4int i = 0; i < analysisManager->GetNofH1s(); ++i)
+	{
+		auto h1 = analysisManager->GetH1(firstID + i, false);
+		if (!h1)
+			continue;
+		out << (first ? "\n" : ",\n") << "    {\"name\": " << Quote(analysisManager->GetH1Name(firstID + i))
+			<< ", \"nBins\": " << h1->axis().bins() << ", \"xMin\": " << h1->axis().lower_edge()
+			<< ", \"xMax\": " << h1->axis().upper_edge() << "}";
+		first = false;
+	}
+	out << "\n  ]\n}\n";
+
+	G4cout << "[Output] Run record written to " << fileName << G4endl;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Quotes a string for JSON.
+ *
+ * Quotes and backslashes are escaped; control characters get their short
+ * escape (newline, tab, carriage return, backspace, form feed) or a
+ * \\u00XX escape. Bytes of multibyte UTF-8 sequences pass unchanged.
+ *
+ * @param text Raw text.
+ * @return The text as a JSON string literal, quotes included.
+ */
+std::string OutputManager::Quote(const std::string &text)
+{
+	std::string quoted = "\"";
+	for (char c : text)
+	{
+		switch (c)
+		{
+		case '"':
+			quoted += "\\\"";
+			break;
+		case '\\':
+			quoted += "\\\\";
+			break;
+		case '\n':
+			quoted += "\\n";
+			break;
+		case '\t':
+			quoted += "\\t";
+			break;
+		case '\r':
+			quoted += "\\r";
+			break;
+		case '\b':
+			quoted += "\\b";
+			break;
+		case '\f':
+			quoted += "\\f";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+			{
+				char escaped[7];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+				quoted += escaped;
+			}
+			else
+			{
+				quoted += c;
+			}
+		}
+	}
+	return quoted + "\"";
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/output/ UI commands.
+ */
+void OutputManager::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/output/", "Output file naming and run records");
+
+	auto &nameCmd = fMessenger->DeclareProperty("name", fTemplate,
+												"Output name template: {run}, {job}, {geometry}, {seed}, {timestamp}.");
+	nameCmd.SetToBeBroadcasted(false);
+
+	auto &jobCmd = fMessenger->DeclareProperty("job", fJob, "Job rank for the {job} token.");
+	jobCmd.SetRange("job>=0");
+	jobCmd.SetToBeBroadcasted(false);
+
+	auto &sidecarCmd = fMessenger->DeclareProperty("sidecar", fSidecar,
+												   "Write a JSON record <name>.json at the end of each run.");
+	sidecarCmd.SetToBeBroadcasted(false);
+}
+// ============================================================================
@@ -0,0 +1,293 @@
+// ============================================================================
+//  File   : PerfCounters.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements per-thread hardware counter collection with Linux
+//           perf_event_open, in per-run or per-event mode.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "PerfCounters.hh"
+
+#include "G4AutoDelete.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the counters of the calling thread, deleted at thread exit.
+ */
+PerfCounters *PerfCounters::Instance()
+{
+	static G4ThreadLocal PerfCounters *instance = nullptr;
+	if (!instance)
+	{
+		instance = new PerfCounters();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ */
+PerfCounters::PerfCounters()
+{
+	fFds.fill(-1);
+	fTotals.fill(0);
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+PerfCounters::~PerfCounters()
+{
+	Close();
+	delete fMessenger;
+}
+
+// ============================================================================
+// Run / Event Hooks
+// ============================================================================
+
+/**
+ * @brief Clears the totals, opens the group and starts it in "run" mode.
+ */
+void PerfCounters::BeginOfRun()
+{
+	fTotals.fill(0);
+	fNumEvents = 0;
+
+	if (fMode == kOff || !Open())
+		return;
+
+	if (fMode == kRun)
+		Start();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Reads the run totals ("run" mode) and closes the group.
+ */
+void PerfCounters::EndOfRun()
+{
+	if (fOpened.empty())
+		return;
+
+	if (fMode == kRun)
+		Stop();
+
+	Close();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Starts counting for one event.
+ */
+void PerfCounters::BeginOfEvent()
+{
+	if (fMode == kEvent && !fOpened.empty())
+		Start();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Adds the counts of one event.
+ */
+void PerfCounters::EndOfEvent()
+{
+	if (fMode == kEvent && !fOpened.empty())
+	{
+		Stop();
+		++fNumEvents;
+	}
+}
+
+// ============================================================================
+// Accessors
+// ============================================================================
+
+/**
+ * @brief Returns the count of a counter, or -1 if it was not available.
+ */
+G4double PerfCounters::GetCount(G4int counter) const
+{
+	if (counter < 0 || counter >= kNumCounters)
+		return -1.;
+
+	for (G4int opened : fOpened)
+	{
+		if (opened == counter)
+			return static_cast<G4double>(fTotals[counter]);
+	}
+	return -1.;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the name of a counter.
+ */
+const char *PerfCounters::GetCounterName(G4int counter)
+{
+	static const char *names[kNumCounters] = {"Cycles", "Instructions", "CacheMisses", "BranchMisses"};
+	return (counter >= 0 && counter < kNumCounters) ? names[counter] : "Unknown";
+}
+
+// ============================================================================
+// perf_event_open Wrappers
+// ============================================================================
+
+/**
+ * @brief Opens the group (cycles as leader) for the calling thread, user space only.
+ *
+ * Counters refused by the kernel are skipped; fOpened lists the others in the
+ * order the group read returns them.
+ */
+G4bool PerfCounters::Open()
+{
+	Close();
+
+#ifdef __linux__
+	static const std::uint64_t configs[kNumCounters] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+														 PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+	for (G4int i = 0; i < kNumCounters; ++i)
+	{
+		int leader = fOpened.empty() ? -1 : fFds[fOpened.front()];
+
+		perf_event_attr attr{};
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = configs[i];
+		attr.disabled = (leader == -1) ? 1 : 0;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP;
+
+		int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+		if (fd < 0)
+			continue;
+
+		fFds[i] = fd;
+		fOpened.push_back(i);
+	}
+#endif
+
+	if (fOpened.size() < static_cast<size_t>(kNumCounters) && !fWarned)
+	{
+		fWarned = true;
+		G4cout << "[PerfCounters] Only " << fOpened.size() << " of " << kNumCounters
+			   << " hardware counters available on this thread"
+#ifdef __linux__
+			   << " (check /proc/sys/kernel/perf_event_paranoid)"
+#else
+			   << " (perf_event_open requires Linux)"
+#endif
+			   << G4endl;
+	}
+
+	return !fOpened.empty();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Closes all open descriptors.
+ */
+void PerfCounters::Close()
+{
+#ifdef __linux__
+	for (int &fd : fFds)
+	{
+		if (fd >= 0)
+			close(fd);
+		fd = -1;
+	}
+#endif
+	fOpened.clear();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Resets and enables the whole group.
+ */
+void PerfCounters::Start()
+{
+#ifdef __linux__
+	int leader = fFds[fOpened.front()];
+	ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Disables the group and adds one group read to the totals.
+ */
+void PerfCounters::Stop()
+{
+#ifdef __linux__
+	int leader = fFds[fOpened.front()];
+	ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+	// PERF_FORMAT_GROUP layout: { u64 nr; u64 value[nr]; }
+	std::uint64_t buffer[1 + kNumCounters] = {};
+	if (read(leader, buffer, sizeof(buffer)) <= 0)
+		return;
+
+	std::uint64_t nr = std::min<std::uint64_t>(buffer[0], fOpened.size());
+	for (std::uint64_t i = 0; i < nr; ++i)
+	{
+		fTotals[fOpened[i]] += buffer[1 + i];
+	}
+#endif
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Applies /ats/perf/mode.
+ */
+void PerfCounters::SetMode(const G4String &mode)
+{
+	if (mode == "run")
+		fMode = kRun;
+	else if (mode == "event")
+		fMode = kEvent;
+	else
+		fMode = kOff;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Declares the /ats/perf/ UI commands.
+ */
+void PerfCounters::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/perf/", "Hardware performance counters (Linux perf_event_open)");
+
+	auto &modeCmd = fMessenger->DeclareMethod("mode", &PerfCounters::SetMode,
+											  "off: disabled | run: count whole runs (cheap) | event: count each event (costly).");
+	modeCmd.SetParameterName("mode", false);
+	modeCmd.SetCandidates("off run event");
+}
+// ============================================================================
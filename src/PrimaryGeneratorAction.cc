@@ -4,7 +4,9 @@
 //  Purpose: Defines and configures the primary particle generator.
 //           Responsible for injecting protons (or other primaries) with
 //           defined energy, position, and direction into the simulation world.
-//           Currently set to emit 1 GeV protons from -15 cm along the +z-axis.
+//           Defaults to 1 GeV protons from -15 cm along the +z-axis; muon
+//           beam modes (monoenergetic, pion decay in flight, surface muons)
+//           can be selected at runtime for moderation studies.
 //
 //  Author : Mohammadreza Zakeri (Zaki)
 //  Email  : m.zakeri@eku.edu
@@ -12,12 +14,27 @@
 // ============================================================================
 
 #include "PrimaryGeneratorAction.hh"
+#include "BeamProfile.hh"
+#include "EventSeeder.hh"
+#include "SlowEventMonitor.hh"
 
 #include "G4Event.hh"
+#include "G4GenericMessenger.hh"
+#include "G4MuonPlus.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4PionPlus.hh"
+#include "G4Proton.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <sstream>
+
+#include <cmath>
 
 // ============================================================================
 // Constructor / Destructor
@@ -27,12 +44,114 @@
  *
  * Initializes a G4ParticleGun to generate single protons with defined
  * energy (1 GeV), position (-15 cm along z), and direction (+z).
+ * Muon-mode defaults: 30 MeV mu+, 150 MeV/c parent pions, pencil beam at -15 cm.
  */
 PrimaryGeneratorAction::PrimaryGeneratorAction()
+	: fMuonEnergy(30. * MeV),
+	  fPionMomentum(150. * MeV),
+	  fMuonPosition(0., 0., -15. * cm)
 {
 	G4int n_particle = 1; // Generate one particle per event
 	fParticleGun = new G4ParticleGun(n_particle);
+	ResetProtonGun();
+
+	fBeamProfile = new BeamProfile();
+	fEventSeeder = EventSeeder::Instance();
+
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ *
+ * Releases memory used by the particle gun.
+ */
+PrimaryGeneratorAction::~PrimaryGeneratorAction()
+{
+	delete fMessenger;
+	delete fBeamProfile;
+	delete fParticleGun;
+}
 
+// ============================================================================
+// GeneratePrimaries
+// ============================================================================
+
+/**
+ * @brief Injects the primary particle(s) into the current event.
+ *
+ * Called by the Geant4 framework at the beginning of each event to define
+ * the primary vertex and particle. In the proton mode the gun keeps the
+ * settings from the constructor unless the Twiss beam model (/ats/beam/enable)
+ * is active; muon modes resample the gun for every primary. With
+ * /ats/gun/primariesPerEvent K, K vertices are generated, each from a fresh
+ * sample. With /ats/seed/perEvent the engine is first seeded from (master seed,
+ * run ID, event ID) and the seeded state is handed to the SlowEventMonitor.
+ * During /ats/slow/replay the recorded RNG state, run/event IDs and event
+ * offset are restored instead; the recorded state already is the seeded one.
+ *
+ * @param anEvent Pointer to the current event.
+ */
+void PrimaryGeneratorAction::GeneratePrimaries(G4Event *anEvent)
+{
+	G4int runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+	G4int eventID = anEvent->GetEventID();
+	G4long eventOffset = fEventSeeder->GetEventOffset();
+
+	if (const SlowEventMonitor::Record *replay = SlowEventMonitor::GetReplayRecord(eventID))
+	{
+		// Replay of a recorded slow event: restore its RNG state, original IDs and offset
+		std::istringstream status(replay->rngStatus);
+		G4Random::restoreFullState(status);
+		runID = replay->runID;
+		eventID = replay->eventID;
+		if (replay->eventOffset >= 0)
+			eventOffset = replay->eventOffset;
+	}
+	else if (fEventSeeder->IsEnabled())
+	{
+		// Thread-independent random stream of this event (opt-in); recorded if the event is slow
+		fEventSeeder->SeedEvent(runID, eventID);
+		SlowEventMonitor::Instance()->RecordSeededState();
+	}
+
+	for (G4int k = 0; k < fPrimariesPerEvent; ++k)
+	{
+		if (fMode != "proton")
+		{
+			ShootMuon();
+			fGunResampled = true;
+		}
+		else if (fBeamProfile->IsEnabled())
+		{
+			// Beam samples stay distinct across the primaries of all events of all jobs
+			G4long globalEventID = eventOffset + eventID;
+			ShootProtonBeam(runID, globalEventID * fPrimariesPerEvent + k);
+			fGunResampled = true;
+		}
+		else if (fGunResampled)
+		{
+			// Switched back from a sampled mode: restore the pencil proton beam
+			ResetProtonGun();
+			fGunResampled = false;
+		}
+
+		fParticleGun->GeneratePrimaryVertex(anEvent);
+	}
+}
+
+// ============================================================================
+// Proton Beam
+// ============================================================================
+
+/**
+ * @brief Configures the particle gun for the default proton beam.
+ *
+ * Single 1 GeV proton from (0, 0, -15 cm) travelling along +z.
+ */
+void PrimaryGeneratorAction::ResetProtonGun()
+{
 	// Define particle type: proton
 	G4ParticleDefinition *particle =
 		G4ParticleTable::GetParticleTable()->FindParticle("proton");
@@ -52,31 +171,158 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
 
 // ----------------------------------------------------------------------------
 /**
- * @brief Destructor
+ * @brief Configures the particle gun from the pre-sampled Twiss beam model.
  *
- * Releases memory used by the particle gun.
+ * The sample is selected by (run ID, sample ID), so the beam of each primary is
+ * independent of the thread that processes it.
+ *
+ * @param runID Run ID of the event (the original one when replaying).
+ * @param sampleID Global event ID (event offset plus event ID) times primaries
+ *                 per event, plus the primary index (from the original event
+ *                 ID when replaying).
  */
-PrimaryGeneratorAction::~PrimaryGeneratorAction()
+void PrimaryGeneratorAction::ShootProtonBeam(G4int runID, G4long sampleID)
 {
-	delete fParticleGun;
+	G4ParticleDefinition *proton = G4Proton::Definition();
+
+	BeamProfile::Sample sample = fBeamProfile->Draw(runID, sampleID, proton->GetPDGMass());
+
+	fParticleGun->SetParticleDefinition(proton);
+	fParticleGun->SetParticlePosition(sample.position);
+	fParticleGun->SetParticleMomentumDirection(sample.direction);
+	fParticleGun->SetParticleEnergy(sample.kineticEnergy);
 }
 
 // ============================================================================
-// GeneratePrimaries
+// Muon Beam Modes
 // ============================================================================
 
 /**
- * @brief Injects the primary particle into the current event.
+ * @brief Configures the particle gun for one muon.
  *
- * Called by the Geant4 framework at the beginning of each event to define
- * the primary vertex and particle. This method triggers the configured
- * G4ParticleGun.
+ * - "muon": fixed kinetic energy, direction from the divergence model.
+ * - "pionDecayMuon": the parent pion travels along the sampled beam direction
+ *   with momentum fPionMomentum and decays isotropically in its rest frame.
+ *   The two-body decay gives a muon momentum p* = (m_pi^2 - m_mu^2) / (2 m_pi)
+ *   in the rest frame, boosted to the lab (flat lab-energy spectrum).
+ * - "surfaceMuon": momentum sampled from dN/dp ~ p^3.5 up to the kinematic
+ *   edge p* (~29.8 MeV/c) by inverting the cumulative p^4.5.
+ */
+void PrimaryGeneratorAction::ShootMuon()
+{
+	G4ParticleDefinition *muon = G4ParticleTable::GetParticleTable()->FindParticle(fMuonSpecies);
+	fParticleGun->SetParticleDefinition(muon);
+	fParticleGun->SetParticlePosition(SamplePosition());
+
+	const G4double mMu = G4MuonPlus::Definition()->GetPDGMass();
+	const G4double mPi = G4PionPlus::Definition()->GetPDGMass();
+	const G4double pStar = (mPi * mPi - mMu * mMu) / (2. * mPi); // two-body decay momentum
+
+	G4ThreeVector beamDir = SampleDirection();
+
+	if (fMode == "muon")
+	{
+		fParticleGun->SetParticleMomentumDirection(beamDir);
+		fParticleGun->SetParticleEnergy(fMuonEnergy);
+	}
+	else if (fMode == "pionDecayMuon")
+	{
+		// Pion boost along the beam direction
+		G4double ePi = std::sqrt(fPionMomentum * fPionMomentum + mPi * mPi);
+		G4double beta = fPionMomentum / ePi;
+		G4double gamma = ePi / mPi;
+
+		// Isotropic decay in the pion rest frame
+		G4double eStar = std::sqrt(pStar * pStar + mMu * mMu);
+		G4double cosTheta = 2. * G4UniformRand() - 1.;
+		G4double sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+		G4double phi = twopi * G4UniformRand();
+
+		G4double pPar = gamma * (pStar * cosTheta + beta * eStar);
+		G4double pPerp = pStar * sinTheta;
+		G4ThreeVector momentum(pPerp * std::cos(phi), pPerp * std::sin(phi), pPar);
+		momentum.rotateUz(beamDir);
+
+		G4double p = momentum.mag();
+		fParticleGun->SetParticleMomentumDirection(momentum.unit());
+		fParticleGun->SetParticleEnergy(std::sqrt(p * p + mMu * mMu) - mMu);
+	}
+	else if (fMode == "surfaceMuon")
+	{
+		G4double p = pStar * std::pow(G4UniformRand(), 1. / 4.5);
+		fParticleGun->SetParticleMomentumDirection(beamDir);
+		fParticleGun->SetParticleEnergy(std::sqrt(p * p + mMu * mMu) - mMu);
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Samples a beam direction around +z.
  *
- * @param anEvent Pointer to the current event.
+ * The projected angles (x', y') are independent Gaussians of width fDivergence.
  */
-void PrimaryGeneratorAction::GeneratePrimaries(G4Event *anEvent)
+G4ThreeVector PrimaryGeneratorAction::SampleDirection() const
+{
+	if (fDivergence <= 0.)
+		return G4ThreeVector(0., 0., 1.);
+
+	G4double xp = G4RandGauss::shoot(0., fDivergence);
+	G4double yp = G4RandGauss::shoot(0., fDivergence);
+	return G4ThreeVector(std::tan(xp), std::tan(yp), 1.).unit();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Samples the vertex position with a round Gaussian spot around fMuonPosition.
+ */
+G4ThreeVector PrimaryGeneratorAction::SamplePosition() const
 {
-	fParticleGun->GeneratePrimaryVertex(anEvent);
+	if (fSpotSigma <= 0.)
+		return fMuonPosition;
+
+	return fMuonPosition + G4ThreeVector(G4RandGauss::shoot(0., fSpotSigma),
+										 G4RandGauss::shoot(0., fSpotSigma), 0.);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Declares the /ats/gun/ UI commands.
+ */
+void PrimaryGeneratorAction::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/gun/", "Primary source configuration");
+
+	auto &primariesCmd = fMessenger->DeclareProperty(
+		"primariesPerEvent", fPrimariesPerEvent,
+		"Independent primaries per event; descendants are tagged with their primary index.");
+	primariesCmd.SetRange("primariesPerEvent>=1");
+
+	auto &modeCmd = fMessenger->DeclareProperty(
+		"mode", fMode, "Source mode: proton | muon | pionDecayMuon | surfaceMuon.");
+	modeCmd.SetCandidates("proton muon pionDecayMuon surfaceMuon");
+
+	auto &speciesCmd = fMessenger->DeclareProperty(
+		"muonSpecies", fMuonSpecies, "Muon species for the muon modes.");
+	speciesCmd.SetCandidates("mu+ mu-");
+
+	auto &energyCmd = fMessenger->DeclarePropertyWithUnit(
+		"muonEnergy", "MeV", fMuonEnergy, "Kinetic energy of monoenergetic muons.");
+	energyCmd.SetRange("muonEnergy>0.");
+
+	auto &pionCmd = fMessenger->DeclarePropertyWithUnit(
+		"pionMomentum", "MeV", fPionMomentum, "Parent pion momentum for pionDecayMuon mode.");
+	pionCmd.SetRange("pionMomentum>0.");
+
+	fMessenger->DeclarePropertyWithUnit(
+		"muonPosition", "cm", fMuonPosition, "Beam origin for the muon modes.");
+
+	auto &spotCmd = fMessenger->DeclarePropertyWithUnit(
+		"spotSigma", "mm", fSpotSigma, "Gaussian transverse spot size (sigma) for the muon modes.");
+	spotCmd.SetRange("spotSigma>=0.");
+
+	auto &divCmd = fMessenger->DeclarePropertyWithUnit(
+		"divergence", "mrad", fDivergence, "Gaussian angular divergence (sigma) for the muon modes.");
+	divCmd.SetRange("divergence>=0.");
 }
 
 // ============================================================================
\ No newline at end of file
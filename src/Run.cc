@@ -0,0 +1,77 @@
+// ============================================================================
+//  File   : Run.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the early release of events stored by the run.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "Run.hh"
+
+#include "G4Event.hh"
+
+#include <algorithm>
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Destructor. Deletes the released events still pending.
+ *
+ * Each of them was seen without grips at an end of event that was followed by
+ * the run manager's clean-up, so no one else refers to it any more.
+ */
+Run::~Run()
+{
+	for (const G4Event *event : fReleasedEvents)
+		delete event;
+}
+
+// ============================================================================
+// Kept Events
+// ============================================================================
+
+/**
+ * @brief Removes a stored event from the run and schedules its deletion.
+ *
+ * Deleting the event deletes its trajectory container, so the memory of all
+ * stored trajectories is returned. An event gripped by the vis manager is in
+ * the run manager's list of previous events: it is un-kept instead, and the run
+ * manager deletes it when the vis manager lets go. An event without grips may
+ * still be in that list until the run manager's next clean-up (at the end of
+ * this event), so its deletion waits for DeleteReleasedEvents().
+ *
+ * @param event Event previously kept in this run.
+ * @return True if the event was found and released.
+ */
+G4bool Run::ReleaseEvent(const G4Event *event)
+{
+	if (!eventVector || !event)
+		return false;
+
+	auto it = std::find(eventVector->begin(), eventVector->end(), event);
+	if (it == eventVector->end())
+		return false;
+
+	eventVector->erase(it);
+	if (event->GetNumberOfGrips() > 0)
+		event->KeepTheEvent(false); // handed to the run manager
+	else
+		fReleasedEvents.push_back(event);
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Deletes the events released at an earlier end of event.
+ */
+void Run::DeleteReleasedEvents()
+{
+	for (const G4Event *event : fReleasedEvents)
+		delete event;
+	fReleasedEvents.clear();
+}
+// ============================================================================
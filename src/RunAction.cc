@@ -11,13 +11,29 @@
 // ============================================================================
 
 #include "RunAction.hh"
+#include "CheckpointManager.hh"
 #include "DetectorConstruction.hh"
+#include "EventDisplayWriter.hh"
+#include "EventSeeder.hh"
+#include "LiveMonitor.hh"
+#include "LooperControl.hh"
+#include "OffscreenRenderer.hh"
+#include "OutputManager.hh"
+#include "RunInterrupt.hh"
+#include "Run.hh"
+#include "SlowEventMonitor.hh"
+#include "StepProfiler.hh"
+#include "G4AccumulableManager.hh"
 #include "G4AnalysisManager.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
 #include "G4ios.hh"
 
+#include <algorithm>
+#include <cmath>
+
 // ============================================================================
 // Constructor / Destructor
 // ============================================================================
@@ -28,9 +44,49 @@
  * Creates a ROOT file and initializes the histogram to track energy deposition
  * in the detector's scoring volume.
  * Initializes histograms for energy, position, target ID, and radial distribution.
+ * Registers the run-level accumulables so they are reset and merged across threads.
  */
 RunAction::RunAction()
 {
+	auto accumulableManager = G4AccumulableManager::Instance();
+	accumulableManager->Register(fResumedEvents);
+	accumulableManager->Register(fNumPrimaries);
+	accumulableManager->Register(fSubEventMuons);
+	accumulableManager->Register(fDTStopSum);
+	accumulableManager->Register(fDTStopSum2);
+	accumulableManager->Register(fAbortedEvents);
+	accumulableManager->Register(fDroppedTracks);
+	accumulableManager->Register(fNumSteps);
+	for (G4int i = 0; i < TrackKiller::kNumReasons; ++i)
+	{
+		accumulableManager->Register(fKilledTracks[i]);
+		accumulableManager->Register(fKilledEnergy[i]);
+	}
+	for (G4int i = 0; i < PerfCounters::kNumCounters; ++i)
+	{
+		accumulableManager->Register(fPerfCounts[i]);
+		accumulableManager->Register(fPerfThreads[i]);
+	}
+	accumulableManager->Register(fPerfEvents);
+	accumulableManager->Register(fLooperTracks);
+	accumulableManager->Register(fLooperMuons);
+	accumulableManager->Register(fLooperEnergy);
+	accumulableManager->Register(fLooperSeconds);
+
+	// Create this thread's profiler, counters, slow-event monitor, looper control,
+	// display writer, renderer, checkpoints, live monitor, output naming and event
+	// seeding so their commands exist before the first run (the master instances
+	// serve /ats/slow/replay, /ats/render/ and /ats/checkpoint/resume)
+	StepProfiler::Instance();
+	PerfCounters::Instance();
+	SlowEventMonitor::Instance();
+	LooperControl::Instance();
+	EventDisplayWriter::Instance();
+	OffscreenRenderer::Instance();
+	CheckpointManager::Instance();
+	LiveMonitor::Instance();
+	OutputManager::Instance();
+	EventSeeder::Instance();
 }
 
 /**
@@ -46,6 +102,17 @@ RunAction::~RunAction()
 // Run Lifecycle Methods
 // ============================================================================
 
+/**
+ * @brief Creates the run object.
+ *
+ * A Run lets the KeptEventManager delete kept events it replaces during the run.
+ */
+G4Run *RunAction::GenerateRun()
+{
+	return new Run();
+}
+
+// ----------------------------------------------------------------------------
 /**
  *  @brief Initializes histograms and opens the ROOT output file.
  *
@@ -57,15 +124,45 @@ RunAction::~RunAction()
  * - Index of the target volume where muon stopped
  * - Radial stopping distance from beam axis
  *
- * @param run Pointer to the current G4Run (unused here).
+ * @param run Pointer to the current G4Run (run ID for the output name and the live monitor).
  */
-void RunAction::BeginOfRunAction(const G4Run *)
+void RunAction::BeginOfRunAction(const G4Run *run)
 {
 	G4cout << "### Run started ###" << G4endl;
 
+	G4AccumulableManager::Instance()->Reset();
+	StepProfiler::Instance()->BeginOfRun();
+	fRunStart = std::chrono::steady_clock::now();
+
+	// A signal received during an earlier run also stops this one before its first event
+	if (IsMaster())
+	{
+		RunInterrupt::BeginOfRun();
+	}
+	RunInterrupt::Poll();
+
+	// Master seed of the per-event streams (fixed by the master before the workers start)
+	EventSeeder::Instance()->BeginOfRun(IsMaster());
+
+	// Transportation processes are thread-local: configure this thread's loopers
+	LooperControl::Instance()->ApplyThresholds();
+
+	// Hardware counters measure the threads that process events (not an idle MT master)
+	if (!IsMaster() || !G4Threading::IsMultithreadedApplication())
+	{
+		PerfCounters::Instance()->BeginOfRun();
+	}
+
 	auto analysisManager = G4AnalysisManager::Instance();
 	analysisManager->SetDefaultFileType("root"); // or "csv", "hdf5", "xml"
-	analysisManager->OpenFile("muon_output");
+	// Same name on all threads: the master resolves /ats/output/name first
+	analysisManager->OpenFile(OutputManager::Instance()->BeginOfRun(run, IsMaster()));
+
+	// Histograms kept from the previous run (CloseFile(false)) start empty: each file holds one run
+	if (analysisManager->GetH1(0, false))
+	{
+		analysisManager->Reset();
+	}
 
 	// Create histograms for muon diagnostics (only if they haven't been already)
 	if (!analysisManager->GetH1(0)) // Check if ID 0 is already created
@@ -81,7 +178,21 @@ void RunAction::BeginOfRunAction(const G4Run *)
 
 		analysisManager->CreateH1("muonStopZ_DT", "Z of Muon Stop in D-T", 100, zStart, zEnd);
 		analysisManager->CreateH1("muonStopR_DT", "Radial R of Muon Stop in D-T", 100, 0, 10 * cm);
+
+		// Normalization: completed events and their primaries (protons on target), filled once per run by the master
+		analysisManager->CreateH1("EventsProcessed", "Completed events", 1, 0., 1.);
+		analysisManager->CreateH1("PrimariesProcessed", "Primaries of the completed events (protons on target)", 1, 0., 1.);
+
+		// Muons created per primary (weighted), one entry per primary
+		analysisManager->CreateH1("MuonsPerPrimary", "Muons per primary", 10, 0., 10.);
 	}
+
+	// Restore a resumed checkpoint (master) and start periodic checkpoints (opt-in)
+	G4bool processing = !IsMaster() || !G4Threading::IsMultithreadedApplication();
+	CheckpointManager::Instance()->BeginOfRun(this, IsMaster(), processing);
+
+	// Live JSON snapshots on a local socket (opt-in)
+	LiveMonitor::Instance()->BeginOfRun(run->GetRunID(), IsMaster(), processing);
 }
 
 /**
@@ -90,13 +201,56 @@ void RunAction::BeginOfRunAction(const G4Run *)
  * Writes data to ROOT file and closes it while retaining histogram memory
  * for post-run visualization in Geant4 (/vis/plot) or offline analysis.
  *
- * @param run Pointer to the current G4Run (unused here).
+ * @param run Pointer to the completed G4Run (used for the event summary).
  */
-void RunAction::EndOfRunAction(const G4Run *)
+void RunAction::EndOfRunAction(const G4Run *run)
 {
 	G4cout << "### Run ended, saving ROOT output... ###" << G4endl;
 
+	if (!IsMaster() || !G4Threading::IsMultithreadedApplication())
+	{
+		CollectPerfCounters();
+		SlowEventMonitor::Instance()->EndOfRun();
+	}
+
+	// Stop checkpointing before the accumulables are merged (the writer reads thread snapshots)
+	CheckpointManager::Instance()->EndOfRun(IsMaster());
+	LiveMonitor::Instance()->EndOfRun(IsMaster());
+
+	G4AccumulableManager::Instance()->Merge();
+	StepProfiler::Instance()->Merge();
+	if (IsMaster())
+	{
+		PrintEventSummary(run);
+		PrintKillerSummary();
+		PrintLooperSummary();
+		PrintFigureOfMerit(run);
+		StepProfiler::Instance()->PrintReport();
+		PrintPerfSummary();
+
+		// Pictures of the best kept muon events, drawn after the vis end of run (no-op unless /ats/render/events > 0)
+		OffscreenRenderer::Instance()->RenderTopEvents(run);
+	}
+
 	auto analysisManager = G4AnalysisManager::Instance();
+
+	// Record the completed event and primary counts in the file (a run interrupted by a signal is still normalizable)
+	if (IsMaster())
+	{
+		G4int nEvents = run->GetNumberOfEvent() + fResumedEvents.GetValue();
+		G4int id = analysisManager->GetH1Id("EventsProcessed", false);
+		if (id >= 0)
+		{
+			analysisManager->FillH1(id, 0.5, nEvents);
+		}
+
+		id = analysisManager->GetH1Id("PrimariesProcessed", false);
+		if (id >= 0)
+		{
+			analysisManager->FillH1(id, 0.5, static_cast<G4double>(fNumPrimaries.GetValue()));
+		}
+	}
+
 	analysisManager->Write();
 
 	// This tells Geant4:
@@ -104,6 +258,325 @@ void RunAction::EndOfRunAction(const G4Run *)
 	//  - Do NOT reset the histograms
 	//  - So they can still be plotted in-session (/vis/plot) or exported to ROOT
 	analysisManager->CloseFile(false);
+
+	// JSON record of the run next to the output file (/ats/output/sidecar)
+	if (IsMaster())
+	{
+		std::map<G4String, G4double> counters;
+		SnapshotCounters(counters);
+		OutputManager::Instance()->WriteSidecar(run, run->GetNumberOfEvent() + fResumedEvents.GetValue(), counters);
+	}
+}
+
+// ============================================================================
+
+// ============================================================================
+// Run-Level Tallies
+// ============================================================================
+
+/**
+ * @brief Tallies a track terminated by the TrackKiller.
+ *
+ * @param reason TrackKiller::Reason that fired.
+ * @param kineticEnergy Kinetic energy of the track at the moment it was killed.
+ */
+void RunAction::RecordKilledTrack(G4int reason, G4double kineticEnergy)
+{
+	if (reason < 0 || reason >= TrackKiller::kNumReasons)
+		return;
+
+	fKilledTracks[reason] += 1;
+	fKilledEnergy[reason] += kineticEnergy;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Tallies a track killed by transportation as a looper.
+ *
+ * @param kineticEnergy Kinetic energy of the looper when it was killed.
+ * @param seconds Wall time spent on the track (from PreUserTrackingAction).
+ * @param isMuon True for muons; their kills are counted separately.
+ */
+void RunAction::RecordLooper(G4double kineticEnergy, G4double seconds, G4bool isMuon)
+{
+	fLooperTracks += 1;
+	fLooperEnergy += kineticEnergy;
+	fLooperSeconds += seconds;
+	if (isMuon)
+		fLooperMuons += 1;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Adds this thread's run counters to a checkpoint.
+ *
+ * The values are the thread-local (not yet merged) accumulables; the
+ * checkpoint writer sums them over threads.
+ *
+ * @param counters Named counters, filled by this method.
+ */
+void RunAction::SnapshotCounters(std::map<G4String, G4double> &counters) const
+{
+	counters["steps"] = fNumSteps.GetValue();
+	counters["primaries"] = fNumPrimaries.GetValue();
+	counters["subEventMuons"] = fSubEventMuons.GetValue();
+	counters["abortedEvents"] = fAbortedEvents.GetValue();
+	counters["droppedTracks"] = fDroppedTracks.GetValue();
+	counters["looperTracks"] = fLooperTracks.GetValue();
+	counters["looperMuons"] = fLooperMuons.GetValue();
+	counters["looperEnergy"] = fLooperEnergy.GetValue();
+	counters["looperSeconds"] = fLooperSeconds.GetValue();
+	for (G4int i = 0; i < TrackKiller::kNumReasons; ++i)
+	{
+		counters[G4String("killedTracks_") + TrackKiller::GetReasonName(i)] = fKilledTracks[i].GetValue();
+		counters[G4String("killedEnergy_") + TrackKiller::GetReasonName(i)] = fKilledEnergy[i].GetValue();
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Adds the counters of a resumed checkpoint to this run (master).
+ *
+ * Unknown names are ignored, so checkpoints stay readable when counters are
+ * added later.
+ *
+ * @param counters Named counters read from the checkpoint.
+ * @param nEvents Events processed before the checkpoint.
+ */
+void RunAction::RestoreCounters(const std::map<G4String, G4double> &counters, G4long nEvents)
+{
+	auto get = [&counters](const G4String &name) {
+		auto it = counters.find(name);
+		return it != counters.end() ? it->second : 0.;
+	};
+
+	fResumedEvents += static_cast<G4int>(nEvents);
+	fNumSteps += static_cast<G4long>(get("steps"));
+	// Checkpoints written before per-event primaries were counted had one per event
+	fNumPrimaries += counters.count("primaries") ? static_cast<G4long>(get("primaries")) : nEvents;
+	fSubEventMuons += get("subEventMuons");
+	fAbortedEvents += static_cast<G4int>(get("abortedEvents"));
+	fDroppedTracks += static_cast<G4int>(get("droppedTracks"));
+	fLooperTracks += static_cast<G4int>(get("looperTracks"));
+	fLooperMuons += static_cast<G4int>(get("looperMuons"));
+	fLooperEnergy += get("looperEnergy");
+	fLooperSeconds += get("looperSeconds");
+	for (G4int i = 0; i < TrackKiller::kNumReasons; ++i)
+	{
+		fKilledTracks[i] += static_cast<G4int>(get(G4String("killedTracks_") + TrackKiller::GetReasonName(i)));
+		fKilledEnergy[i] += get(G4String("killedEnergy_") + TrackKiller::GetReasonName(i));
+	}
 }
 
-// ============================================================================
\ No newline at end of file
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the number of processed events and how many were aborted early.
+ *
+ * Also reports how many deferred tracks the StackingAction discarded.
+ * Aborted events are still protons on target: yields per proton must be
+ * normalized to all primaries of all events (events times
+ * /ats/gun/primariesPerEvent), not to the non-aborted events.
+ *
+ * @param run Pointer to the completed (merged) run.
+ */
+void RunAction::PrintEventSummary(const G4Run *run) const
+{
+	G4int nEvents = run->GetNumberOfEvent() + fResumedEvents.GetValue();
+	G4int nAborted = fAbortedEvents.GetValue();
+
+	G4cout << "=== Event Summary ===" << G4endl;
+	G4cout << "Events: " << nEvents
+		   << " | Protons on target: " << fNumPrimaries.GetValue()
+		   << " | Aborted early (no muon precursor): " << nAborted
+		   << " | Fully tracked: " << nEvents - nAborted << G4endl;
+
+	if (fResumedEvents.GetValue() > 0)
+	{
+		G4cout << "Including events from the resumed checkpoint: " << fResumedEvents.GetValue() << G4endl;
+	}
+
+	if (RunInterrupt::GetSignal() != 0)
+	{
+		G4cout << "Run interrupted by signal " << RunInterrupt::GetSignal() << ": " << run->GetNumberOfEvent()
+			   << " of " << run->GetNumberOfEventToBeProcessed() << " requested events completed" << G4endl;
+	}
+
+	if (fDroppedTracks.GetValue() > 0)
+	{
+		G4cout << "Deferred tracks dropped after the muon chain: " << fDroppedTracks.GetValue() << G4endl;
+	}
+
+	if (fSubEventMuons.GetValue() > 0.)
+	{
+		G4cout << "Muons created in sub-events (in MuonEnergy, not in MuonsPerPrimary or kept events): "
+			   << fSubEventMuons.GetValue() << G4endl;
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the per-run track killer tallies.
+ *
+ * Shows, for each kill reason, how many tracks were removed, the total kinetic
+ * energy they carried and the mean energy per track. Nothing is printed if the
+ * killer did not fire during the run.
+ */
+void RunAction::PrintKillerSummary() const
+{
+	G4int total = 0;
+	for (const auto &count : fKilledTracks)
+		total += count.GetValue();
+
+	if (total == 0)
+		return;
+
+	G4cout << "=== Track Killer Summary ===" << G4endl;
+	for (G4int i = 0; i < TrackKiller::kNumReasons; ++i)
+	{
+		G4int n = fKilledTracks[i].GetValue();
+		G4double e = fKilledEnergy[i].GetValue();
+		G4cout << TrackKiller::GetReasonName(i)
+			   << " | Tracks: " << n
+			   << " | Energy: " << e / MeV << " MeV"
+			   << " | Mean: " << (n > 0 ? e / n / MeV : 0.) << " MeV"
+			   << G4endl;
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the per-run looper tallies.
+ *
+ * The time is the wall time from the start of each killed track to its kill,
+ * summed over threads: the time the loopers took before transportation gave up
+ * on them (close to their CPU cost only if the threads were not preempted).
+ * Looping muons are listed separately: they are excluded from the stop
+ * histograms, so a non-zero count means stopping statistics lost entries and
+ * the thresholds (/ats/looper/) should be raised. Nothing is printed if no
+ * looper was killed during the run.
+ */
+void RunAction::PrintLooperSummary() const
+{
+	G4int n = fLooperTracks.GetValue();
+	if (n == 0)
+		return;
+
+	G4cout << "=== Looper Summary ===" << G4endl;
+	G4cout << "Loopers killed: " << n
+		   << " | Energy: " << fLooperEnergy.GetValue() / MeV << " MeV"
+		   << " | Wall: " << fLooperSeconds.GetValue() << " s"
+		   << " | Mean: " << 1000. * fLooperSeconds.GetValue() / n << " ms/track"
+		   << G4endl;
+	G4cout << "Muon loopers (not scored as stops): " << fLooperMuons.GetValue() << G4endl;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the D-T stop tally with its relative error and figure of merit.
+ *
+ * The samples are the per-event weighted D-T stops, so the correlation of the
+ * split copies within an event is accounted for. With R the relative error of
+ * the mean and T the wall time of the run, FOM = 1 / (R^2 T): the figure to
+ * compare between /ats/bias/ settings (higher is better). In sub-event mode the
+ * parts of an event count as separate samples, which makes R approximate.
+ * Events taken over from a checkpoint are not included.
+ *
+ * @param run Pointer to the completed (merged) run.
+ */
+void RunAction::PrintFigureOfMerit(const G4Run *run) const
+{
+	G4int n = run->GetNumberOfEvent();
+	G4double sum = fDTStopSum.GetValue();
+	if (n < 2 || sum <= 0.)
+	{
+		G4cout << "[FOM] No muon stops in the D-T gas; figure of merit undefined" << G4endl;
+		return;
+	}
+
+	G4double mean = sum / n;
+	G4double variance = std::max(0., fDTStopSum2.GetValue() / n - mean * mean) * n / (n - 1);
+	G4double relError = std::sqrt(variance / n) / mean;
+	G4double seconds = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fRunStart).count();
+
+	G4cout << "[FOM] D-T stops/event: " << mean
+		   << " | Rel. error: " << relError
+		   << " | Wall: " << seconds << " s";
+	if (relError > 0. && seconds > 0.)
+	{
+		G4cout << " | FOM = 1/(R^2 T): " << 1. / (relError * relError * seconds) << " /s";
+	}
+	G4cout << G4endl;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Stops this thread's hardware counters and adds them to the accumulables.
+ *
+ * Each thread prints its own line, so per-thread imbalance (e.g. one worker with
+ * a much lower IPC) is visible next to the merged totals.
+ */
+void RunAction::CollectPerfCounters()
+{
+	auto perf = PerfCounters::Instance();
+	if (perf->GetMode() == PerfCounters::kOff)
+		return;
+
+	perf->EndOfRun();
+
+	G4cout << "[PerfCounters] Thread " << G4Threading::G4GetThreadId();
+	for (G4int i = 0; i < PerfCounters::kNumCounters; ++i)
+	{
+		G4double count = perf->GetCount(i);
+		G4cout << " | " << PerfCounters::GetCounterName(i) << ": ";
+		if (count < 0.)
+		{
+			G4cout << "n/a";
+			continue;
+		}
+		G4cout << count;
+		fPerfCounts[i] += count;
+		fPerfThreads[i] += 1;
+	}
+	G4cout << G4endl;
+
+	fPerfEvents += perf->GetNumEvents();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the merged hardware counts.
+ *
+ * Derived figures: instructions per cycle and cache / branch misses per
+ * kilo-instruction (MPKI). A low IPC with high cache MPKI that worsens with the
+ * thread count points to memory-bound navigation or cross-section lookups. In
+ * per-event mode the mean counts per event are shown as well.
+ */
+void RunAction::PrintPerfSummary() const
+{
+	if (PerfCounters::Instance()->GetMode() == PerfCounters::kOff)
+		return;
+
+	G4cout << "=== Performance Counter Summary ===" << G4endl;
+	for (G4int i = 0; i < PerfCounters::kNumCounters; ++i)
+	{
+		G4cout << PerfCounters::GetCounterName(i) << " | Threads: " << fPerfThreads[i].GetValue();
+		if (fPerfThreads[i].GetValue() > 0)
+		{
+			G4cout << " | Total: " << fPerfCounts[i].GetValue();
+			if (fPerfEvents.GetValue() > 0)
+				G4cout << " | Per event: " << fPerfCounts[i].GetValue() / fPerfEvents.GetValue();
+		}
+		G4cout << G4endl;
+	}
+
+	G4double cycles = fPerfCounts[PerfCounters::kCycles].GetValue();
+	G4double instructions = fPerfCounts[PerfCounters::kInstructions].GetValue();
+	if (cycles > 0. && instructions > 0.)
+	{
+		G4cout << "IPC: " << instructions / cycles
+			   << " | Cache MPKI: " << 1000. * fPerfCounts[PerfCounters::kCacheMisses].GetValue() / instructions
+			   << " | Branch MPKI: " << 1000. * fPerfCounts[PerfCounters::kBranchMisses].GetValue() / instructions
+			   << G4endl;
+	}
+}
+// ============================================================================
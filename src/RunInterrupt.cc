@@ -0,0 +1,89 @@
+// ============================================================================
+//  File   : RunInterrupt.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the SIGINT/SIGTERM handler and the soft abort of the
+//           current run.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "RunInterrupt.hh"
+
+#include "G4RunManager.hh"
+#include "G4ios.hh"
+
+#ifdef G4MULTITHREADED
+#include "G4MTRunManager.hh"
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+volatile std::sig_atomic_t RunInterrupt::fSignal = 0;
+std::atomic<G4bool> RunInterrupt::fAbortRequested{false};
+
+// ============================================================================
+// Signal Handling
+// ============================================================================
+
+/**
+ * @brief Installs the SIGINT and SIGTERM handlers.
+ *
+ * SA_RESETHAND restores the default action after the first signal, so a
+ * second Ctrl-C (or SIGTERM) kills the job at once.
+ */
+void RunInterrupt::Install()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	struct sigaction action = {};
+	action.sa_handler = &RunInterrupt::Handle;
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = SA_RESETHAND | SA_RESTART;
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Records the signal; everything else happens in Poll().
+ */
+void RunInterrupt::Handle(int signal)
+{
+	fSignal = signal;
+
+#if defined(__unix__) || defined(__APPLE__)
+	static const char message[] = "\n[Signal] Interrupt received: finishing in-flight events and writing output "
+								  "(send again to terminate immediately)\n";
+	ssize_t ignored = write(STDERR_FILENO, message, sizeof(message) - 1);
+	(void)ignored;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Requests a soft abort of the current run if a signal was received.
+ *
+ * Only the first poll per run issues the abort. In multithreaded mode the
+ * master run manager broadcasts it to all workers.
+ */
+void RunInterrupt::Poll()
+{
+	if (fSignal == 0 || fAbortRequested.exchange(true))
+		return;
+
+	G4cout << "[Signal] Aborting the run after the events in flight (signal " << static_cast<G4int>(fSignal) << ")" << G4endl;
+
+#ifdef G4MULTITHREADED
+	if (auto master = G4MTRunManager::GetMasterRunManager())
+	{
+		master->AbortRun(true);
+		return;
+	}
+#endif
+	G4RunManager::GetRunManager()->AbortRun(true);
+}
+// ============================================================================
@@ -0,0 +1,97 @@
+// ============================================================================
+//  File   : RunSnapshot.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the capture and merge of per-thread run snapshots.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "RunSnapshot.hh"
+#include "RunAction.hh"
+
+#include "G4AnalysisManager.hh"
+
+// ============================================================================
+// RunSnapshot
+// ============================================================================
+
+/**
+ * @brief Copies the H1 histograms of this thread and the RunAction counters.
+ *
+ * Missing histograms (inactive IDs) are kept as empty entries with nBins 0, so
+ * histogram i has the same position in the snapshots of all threads.
+ */
+void RunSnapshot::Capture(const RunAction *runAction, G4bool withErrors)
+{
+	auto analysisManager = G4AnalysisManager::Instance();
+	G4int firstID = analysisManager->GetFirstH1Id();
+	G4int nH1 = analysisManager->GetNofH1s();
+	histograms.resize(nH1);
+	for (G4int i = 0; i < nH1; ++i)
+	{
+		auto h1 = analysisManager->GetH1(firstID + i, false);
+		Histogram &histogram = histograms[i];
+		if (!h1)
+		{
+			histogram.nBins = 0;
+			continue;
+		}
+
+		histogram.name = analysisManager->GetH1Name(firstID + i);
+		histogram.nBins = h1->axis().bins();
+		histogram.xMin = h1->axis().lower_edge();
+		histogram.xMax = h1->axis().upper_edge();
+		histogram.entries = h1->all_entries();
+		histogram.sumW = h1->bins_sum_w();
+		if (withErrors)
+		{
+			histogram.title = h1->title();
+			histogram.sumW2 = h1->bins_sum_w2();
+		}
+	}
+
+	counters.clear();
+	runAction->SnapshotCounters(counters);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Adds another snapshot.
+ *
+ * Histograms are matched by position; one that is empty here is copied, one
+ * with a different binning is skipped. The RNG state is not merged.
+ */
+void RunSnapshot::Add(const RunSnapshot &other)
+{
+	events += other.events;
+	nextEvent = std::max(nextEvent, other.nextEvent);
+	for (const auto &[name, value] : other.counters)
+		counters[name] += value;
+
+	if (histograms.size() < other.histograms.size())
+		histograms.resize(other.histograms.size());
+
+	for (size_t i = 0; i < other.histograms.size(); ++i)
+	{
+		Histogram &h = histograms[i];
+		const Histogram &o = other.histograms[i];
+		if (o.nBins == 0)
+			continue;
+		if (h.nBins == 0)
+		{
+			h = o;
+			continue;
+		}
+		if (h.nBins != o.nBins || h.sumW.size() != o.sumW.size())
+			continue;
+
+		h.entries += o.entries;
+		for (size_t b = 0; b < h.sumW.size(); ++b)
+			h.sumW[b] += o.sumW[b];
+		for (size_t b = 0; b < h.sumW2.size() && b < o.sumW2.size(); ++b)
+			h.sumW2[b] += o.sumW2[b];
+	}
+}
+// ============================================================================
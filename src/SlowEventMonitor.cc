@@ -0,0 +1,401 @@
+// ============================================================================
+//  File   : SlowEventMonitor.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements per-event timing, the running latency histogram, the
+//           slow-event record file and the replay of recorded events.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "SlowEventMonitor.hh"
+#include "EventSeeder.hh"
+
+#include "G4AutoDelete.hh"
+#include "G4Event.hh"
+#include "G4GenericMessenger.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4UImanager.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+std::vector<SlowEventMonitor::Record> SlowEventMonitor::fReplayRecords;
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the monitor of the calling thread, deleted at thread exit.
+ */
+SlowEventMonitor *SlowEventMonitor::Instance()
+{
+	static G4ThreadLocal SlowEventMonitor *instance = nullptr;
+	if (!instance)
+	{
+		instance = new SlowEventMonitor();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ *
+ * Defaults: events above the 99.9th percentile are recorded after 100 events.
+ */
+SlowEventMonitor::SlowEventMonitor()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+SlowEventMonitor::~SlowEventMonitor()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Per-Event Timing
+// ============================================================================
+
+/**
+ * @brief Starts the event timer.
+ */
+void SlowEventMonitor::BeginEvent()
+{
+	if (!fEnabled)
+		return;
+
+	fSpeciesSteps.clear();
+	fStart = Clock::now();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Keeps the engine state just after per-event reseeding.
+ *
+ * GeneratePrimaries() runs before BeginOfEventAction(), so the state is
+ * cleared at the end of the event rather than at its beginning.
+ */
+void SlowEventMonitor::RecordSeededState()
+{
+	if (!fEnabled)
+		return;
+
+	std::ostringstream status;
+	G4Random::saveFullState(status);
+	fSeededStatus = status.str();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Times the event, compares it with the running percentile and records it if slow.
+ *
+ * The threshold is taken from the histogram before the event is added, so a
+ * single pathological event cannot raise its own threshold.
+ *
+ * @param event Pointer to the finished event.
+ */
+void SlowEventMonitor::EndEvent(const G4Event *event)
+{
+	if (!fEnabled)
+		return;
+
+	G4double seconds = std::chrono::duration<G4double>(Clock::now() - fStart).count();
+
+	G4long nTimed = 0;
+	for (G4long count : fHistogram)
+		nTimed += count;
+
+	G4bool slow = nTimed >= fWarmupEvents && seconds > GetPercentile(fPercentile);
+
+	++fHistogram[GetBin(seconds)];
+	++fNumEvents;
+	fMaxSeconds = std::max(fMaxSeconds, seconds);
+
+	// Events being replayed are not recorded again
+	if (slow && fReplayRecords.empty())
+	{
+		++fNumSlow;
+		WriteRecord(event, seconds);
+	}
+	fSeededStatus.clear();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the latency statistics of this thread and resets the run counters.
+ *
+ * The histogram itself is kept, so the percentile keeps improving across runs.
+ */
+void SlowEventMonitor::EndOfRun()
+{
+	if (!fEnabled || fNumEvents == 0)
+		return;
+
+	G4cout << "[SlowEvents] Thread " << G4Threading::G4GetThreadId()
+		   << " | Events: " << fNumEvents
+		   << " | Median: " << GetPercentile(50.) << " s"
+		   << " | P" << fPercentile << ": " << GetPercentile(fPercentile) << " s"
+		   << " | Max: " << fMaxSeconds << " s"
+		   << " | Recorded: " << fNumSlow << G4endl;
+
+	fNumEvents = 0;
+	fNumSlow = 0;
+	fMaxSeconds = 0.;
+	if (fOutput.is_open())
+		fOutput.flush();
+}
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+/**
+ * @brief Returns the bin of a duration (10 bins per decade starting at 1 us).
+ */
+G4int SlowEventMonitor::GetBin(G4double seconds)
+{
+	if (seconds <= 1.e-6)
+		return 0;
+
+	G4int bin = static_cast<G4int>(10. * std::log10(seconds / 1.e-6));
+	return std::min(bin, kNumBins - 1);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the upper edge of a bin in seconds.
+ */
+G4double SlowEventMonitor::GetBinEdge(G4int bin)
+{
+	return 1.e-6 * std::pow(10., (bin + 1) / 10.);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the upper edge of the bin containing the given percentile.
+ *
+ * The estimate is coarse (a factor 10^0.1 = 1.26), which is ample for telling
+ * 100x outliers from the bulk.
+ */
+G4double SlowEventMonitor::GetPercentile(G4double percentile) const
+{
+	G4long total = 0;
+	for (G4long count : fHistogram)
+		total += count;
+	if (total == 0)
+		return 0.;
+
+	G4double target = percentile / 100. * total;
+	G4long cumulative = 0;
+	for (G4int bin = 0; bin < kNumBins; ++bin)
+	{
+		cumulative += fHistogram[bin];
+		if (cumulative >= target)
+			return GetBinEdge(bin);
+	}
+	return GetBinEdge(kNumBins - 1);
+}
+
+// ============================================================================
+// Record File
+// ============================================================================
+
+/**
+ * @brief Appends one slow event to the record file of this thread.
+ *
+ * Format (one block per event):
+ * @code
+ * event <runID> <eventID> <seconds> <eventOffset>
+ * primary <name> <Ekin MeV> <x> <y> <z mm> <dx> <dy> <dz>
+ * steps <name> <count>
+ * rng-begin
+ * <engine state as written by G4Random::saveFullState>
+ * rng-end
+ * @endcode
+ * The engine state is the one after per-event reseeding if there was one,
+ * otherwise the one the run manager stored before primary generation.
+ */
+void SlowEventMonitor::WriteRecord(const G4Event *event, G4double seconds)
+{
+	if (!fOutput.is_open())
+	{
+		G4String name = fFileName;
+		if (G4Threading::IsWorkerThread())
+			name += "_t" + std::to_string(G4Threading::G4GetThreadId());
+		fOutput.open(name + ".txt", std::ios::app);
+	}
+
+	const G4Run *run = G4RunManager::GetRunManager()->GetCurrentRun();
+	fOutput << "event " << (run ? run->GetRunID() : 0) << " " << event->GetEventID() << " " << seconds
+			<< " " << EventSeeder::Instance()->GetEventOffset() << "\n";
+
+	for (G4int v = 0; v < event->GetNumberOfPrimaryVertex(); ++v)
+	{
+		const G4PrimaryVertex *vertex = event->GetPrimaryVertex(v);
+		for (const G4PrimaryParticle *p = vertex->GetPrimary(); p; p = p->GetNext())
+		{
+			G4ThreeVector dir = p->GetMomentumDirection();
+			fOutput << "primary " << p->GetParticleDefinition()->GetParticleName()
+					<< " " << p->GetKineticEnergy() / MeV
+					<< " " << vertex->GetX0() / mm << " " << vertex->GetY0() / mm << " " << vertex->GetZ0() / mm
+					<< " " << dir.x() << " " << dir.y() << " " << dir.z() << "\n";
+		}
+	}
+
+	for (const auto &[particle, count] : fSpeciesSteps)
+	{
+		fOutput << "steps " << particle->GetParticleName() << " " << count << "\n";
+	}
+
+	fOutput << "rng-begin\n"
+			<< (fSeededStatus.empty() ? G4String(event->GetRandomNumberStatus()) : G4String(fSeededStatus)) << "\n"
+			<< "rng-end\n";
+	fOutput.flush();
+
+	G4cout << "[SlowEvent] Run " << (run ? run->GetRunID() : 0) << " | Event " << event->GetEventID()
+		   << " | " << seconds << " s (P" << fPercentile << " = " << GetPercentile(fPercentile) << " s)" << G4endl;
+}
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+/**
+ * @brief Returns the record replayed as event eventID, or nullptr outside a replay.
+ */
+const SlowEventMonitor::Record *SlowEventMonitor::GetReplayRecord(G4int eventID)
+{
+	if (eventID < 0 || eventID >= static_cast<G4int>(fReplayRecords.size()))
+		return nullptr;
+	return &fReplayRecords[eventID];
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Reads a record file and runs its events with verbose tracking.
+ *
+ * Executed on the master only. The records are read before the run starts
+ * and stay untouched until it ends, so workers can read them without locking.
+ *
+ * @param fileName Record file written by a previous run.
+ */
+void SlowEventMonitor::Replay(const G4String &fileName)
+{
+	std::ifstream in(fileName);
+	if (!in)
+	{
+		G4Exception("SlowEventMonitor::Replay()", "FileNotFound", JustWarning,
+					("Cannot open slow-event file " + fileName).c_str());
+		return;
+	}
+
+	std::vector<Record> records;
+	std::string line;
+	G4bool inRng = false;
+	while (std::getline(in, line))
+	{
+		if (inRng)
+		{
+			if (line == "rng-end")
+				inRng = false;
+			else
+				records.back().rngStatus += line + "\n";
+		}
+		else if (line.rfind("event ", 0) == 0)
+		{
+			Record record;
+			std::istringstream fields(line.substr(6));
+			fields >> record.runID >> record.eventID >> record.seconds;
+			if (!(fields >> record.eventOffset))
+				record.eventOffset = -1;
+			records.push_back(record);
+		}
+		else if (line == "rng-begin" && !records.empty())
+		{
+			inRng = true;
+		}
+	}
+
+	records.erase(std::remove_if(records.begin(), records.end(),
+								 [](const Record &r) { return r.rngStatus.empty(); }),
+				  records.end());
+	if (records.empty())
+	{
+		G4cout << "[SlowEvents] No replayable events in " << fileName << G4endl;
+		return;
+	}
+
+	G4cout << "[SlowEvents] Replaying " << records.size() << " event(s) from " << fileName << G4endl;
+
+	fReplayRecords = records;
+	auto UImanager = G4UImanager::GetUIpointer();
+	UImanager->ApplyCommand("/tracking/verbose 1");
+	UImanager->ApplyCommand("/run/beamOn " + std::to_string(records.size()));
+	UImanager->ApplyCommand("/tracking/verbose 0");
+	fReplayRecords.clear();
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Enables monitoring and asks the run manager to keep each event's RNG state.
+ */
+void SlowEventMonitor::SetEnabled(G4bool enabled)
+{
+	fEnabled = enabled;
+	if (enabled)
+	{
+		G4RunManager::GetRunManager()->StoreRandomNumberStatusToG4Event(1);
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Declares the /ats/slow/ UI commands.
+ */
+void SlowEventMonitor::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/slow/", "Slow-event detection and replay");
+
+	auto &enableCmd = fMessenger->DeclareMethod("enable", &SlowEventMonitor::SetEnabled,
+												"Time every event and record those above the percentile.");
+	enableCmd.SetParameterName("enable", true);
+	enableCmd.SetDefaultValue("true");
+
+	auto &percentileCmd = fMessenger->DeclareProperty("percentile", fPercentile,
+													  "Events slower than this percentile of the running histogram are recorded.");
+	percentileCmd.SetRange("percentile>0. && percentile<100.");
+
+	auto &warmupCmd = fMessenger->DeclareProperty("warmup", fWarmupEvents,
+												  "Events timed before any event can be flagged as slow.");
+	warmupCmd.SetRange("warmup>=1");
+
+	fMessenger->DeclareProperty("file", fFileName,
+								"Base name of the record file (_t<thread> and .txt are appended).");
+
+	auto &replayCmd = fMessenger->DeclareMethod("replay", &SlowEventMonitor::Replay,
+												"Re-run the events of a record file with /tracking/verbose 1.");
+	replayCmd.SetParameterName("file", false);
+	replayCmd.SetToBeBroadcasted(false);
+}
+// ============================================================================
@@ -0,0 +1,145 @@
+// ============================================================================
+//  File   : StackingAction.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements priority stacking: muon ancestors are urgent, the rest
+//           of the shower waits and can be dropped once the muon chain is done.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "StackingAction.hh"
+#include "MuonAncestry.hh"
+#include "RunAction.hh"
+#include "SubEventParallelism.hh"
+
+#include "G4EventManager.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Neutron.hh"
+#include "G4Proton.hh"
+#include "G4RunManager.hh"
+#include "G4StackManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Constructor
+ *
+ * The nucleon threshold defaults to 280 MeV, just below single-pion production.
+ */
+StackingAction::StackingAction()
+	: fNucleonThreshold(280. * MeV)
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+StackingAction::~StackingAction()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Stacking Hooks
+// ============================================================================
+
+/**
+ * @brief Classifies a new track.
+ *
+ * With priority stacking disabled every track is urgent (Geant4 default).
+ * In sub-event parallel mode the shower tracks of an event (not of a sub-event)
+ * are shipped to sub-events, with or without priority stacking.
+ */
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track *track)
+{
+	if (SubEventParallelism::IsActive() && !IsMuonAncestor(track) &&
+		!SubEventParallelism::IsSubEvent(G4EventManager::GetEventManager()->GetConstCurrentEvent()))
+	{
+		return SubEventParallelism::GetShowerClassification();
+	}
+
+	if (!fPriority || IsMuonAncestor(track))
+		return fUrgent;
+
+	return fWaiting;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Drops the deferred shower once the muon chain has been transported.
+ *
+ * Geant4 has already moved the waiting tracks to the urgent stack when this is
+ * called, so clearing the stacks removes exactly the deferred tracks. Tracks
+ * produced later are classified again, hence muon ancestors created by deferred
+ * tracks are never lost in "transport" mode.
+ */
+void StackingAction::NewStage()
+{
+	if (!fPriority || !fDropDeferred)
+		return;
+
+	G4int nDropped = stackManager->GetNUrgentTrack() + stackManager->GetNWaitingTrack();
+	if (nDropped == 0)
+		return;
+
+	stackManager->clear();
+
+	auto runAction = const_cast<RunAction *>(
+		static_cast<const RunAction *>(G4RunManager::GetRunManager()->GetUserRunAction()));
+	if (runAction)
+	{
+		runAction->RecordDroppedTracks(nDropped);
+	}
+}
+
+// ============================================================================
+// Private Helpers
+// ============================================================================
+
+/**
+ * @brief Returns true for tracks that may lead to a muon.
+ *
+ * Primaries, the muon chain of MuonAncestry::IsMuonAncestor() and nucleons
+ * above the threshold.
+ */
+G4bool StackingAction::IsMuonAncestor(const G4Track *track) const
+{
+	if (track->GetParentID() == 0)
+		return true;
+
+	const G4ParticleDefinition *particle = track->GetDefinition();
+	if (MuonAncestry::IsMuonAncestor(particle))
+		return true;
+
+	return (particle == G4Proton::Definition() || particle == G4Neutron::Definition()) &&
+		   track->GetKineticEnergy() > fNucleonThreshold;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Declares the /ats/stack/ UI commands.
+ */
+void StackingAction::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/stack/", "Priority stacking of muon ancestors");
+
+	fMessenger->DeclareProperty("priority", fPriority,
+								"Track pions, kaons, muons and energetic nucleons first; defer the rest.");
+
+	fMessenger->DeclareProperty("dropDeferred", fDropDeferred,
+								"Discard deferred tracks after the muon chain (approximate for muon observables).");
+
+	auto &thresholdCmd = fMessenger->DeclarePropertyWithUnit(
+		"nucleonThreshold", "MeV", fNucleonThreshold,
+		"Nucleons above this kinetic energy are tracked with the muon ancestors.");
+	thresholdCmd.SetRange("nucleonThreshold>=0.");
+}
+// ============================================================================
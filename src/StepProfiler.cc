@@ -0,0 +1,197 @@
+// ============================================================================
+//  File   : StepProfiler.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the per-thread (particle, volume) cost tables, their
+//           merge at the end of a run and the sorted cost report.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "StepProfiler.hh"
+
+#include "G4AutoDelete.hh"
+#include "G4AutoLock.hh"
+#include "G4GenericMessenger.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+namespace
+{
+/// Merged table of all threads, guarded by gMergeMutex.
+std::unordered_map<const void *, std::unordered_map<const void *, StepProfiler::Entry>> gMerged;
+G4Mutex gMergeMutex = G4MUTEX_INITIALIZER;
+} // namespace
+
+// ============================================================================
+// Instance / Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Returns the profiler of the calling thread.
+ *
+ * Created by the first caller on each thread (RunAction, SteppingAction or
+ * TrackingAction) and deleted at thread exit.
+ */
+StepProfiler *StepProfiler::Instance()
+{
+	static G4ThreadLocal StepProfiler *instance = nullptr;
+	if (!instance)
+	{
+		instance = new StepProfiler();
+		G4AutoDelete::Register(instance);
+	}
+	return instance;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Constructor
+ */
+StepProfiler::StepProfiler()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+StepProfiler::~StepProfiler()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Run Lifecycle
+// ============================================================================
+
+/**
+ * @brief Clears the per-thread table; the master also clears the merged table.
+ */
+void StepProfiler::BeginOfRun()
+{
+	fTable.clear();
+	fLastEntry = nullptr;
+	fLastKey = Key(nullptr, nullptr);
+
+	if (G4Threading::IsMasterThread())
+	{
+		G4AutoLock lock(&gMergeMutex);
+		gMerged.clear();
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Adds this thread's entries to the merged table.
+ *
+ * Particle definitions and logical volumes are shared by all threads, so the
+ * pointer keys are valid across threads.
+ */
+void StepProfiler::Merge()
+{
+	if (fTable.empty())
+		return;
+
+	G4AutoLock lock(&gMergeMutex);
+	for (const auto &[key, entry] : fTable)
+	{
+		Entry &merged = gMerged[key.first][key.second];
+		merged.tracks += entry.tracks;
+		merged.steps += entry.steps;
+		merged.seconds += entry.seconds;
+	}
+
+	fTable.clear();
+	fLastEntry = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the merged table sorted by total time.
+ *
+ * Columns: particle, volume, tracks, steps, total time, share of the profiled
+ * time and mean time per step.
+ */
+void StepProfiler::PrintReport() const
+{
+	if (!fEnabled)
+		return;
+
+	struct Row
+	{
+		G4String particle;
+		G4String volume;
+		Entry entry;
+	};
+
+	std::vector<Row> rows;
+	G4double totalSeconds = 0.;
+	G4long totalSteps = 0;
+	{
+		G4AutoLock lock(&gMergeMutex);
+		for (const auto &[particle, volumes] : gMerged)
+		{
+			for (const auto &[volume, entry] : volumes)
+			{
+				auto p = static_cast<const G4ParticleDefinition *>(particle);
+				auto v = static_cast<const G4LogicalVolume *>(volume);
+				rows.push_back({p ? p->GetParticleName() : "unknown", v ? v->GetName() : "unknown", entry});
+				totalSeconds += entry.seconds;
+				totalSteps += entry.steps;
+			}
+		}
+	}
+
+	if (rows.empty())
+		return;
+
+	std::sort(rows.begin(), rows.end(),
+			  [](const Row &a, const Row &b) { return a.entry.seconds > b.entry.seconds; });
+
+	G4cout << "=== Step Profiler Summary ===" << G4endl;
+	G4cout << "Profiled time: " << totalSeconds << " s | Steps: " << totalSteps
+		   << " | Pairs: " << rows.size() << G4endl;
+
+	size_t nRows = std::min(rows.size(), static_cast<size_t>(fTopN));
+	for (size_t i = 0; i < nRows; ++i)
+	{
+		const Entry &e = rows[i].entry;
+		G4cout << std::left << std::setw(12) << rows[i].particle
+			   << " | " << std::setw(20) << rows[i].volume << std::right
+			   << " | Tracks: " << std::setw(9) << e.tracks
+			   << " | Steps: " << std::setw(10) << e.steps
+			   << " | Time: " << std::setw(9) << std::setprecision(4) << e.seconds << " s"
+			   << " | " << std::setw(5) << std::setprecision(3) << (totalSeconds > 0. ? 100. * e.seconds / totalSeconds : 0.) << " %"
+			   << " | " << std::setprecision(3) << (e.steps > 0 ? 1.e6 * e.seconds / e.steps : 0.) << " us/step"
+			   << G4endl;
+	}
+	G4cout << std::setprecision(6);
+}
+
+// ============================================================================
+// Private Helpers
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/profile/ UI commands.
+ */
+void StepProfiler::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/profile/", "Per-particle, per-volume step profiler");
+
+	fMessenger->DeclareProperty("enable", fEnabled,
+								"Accumulate steps, tracks and wall time per (particle, volume) pair.");
+
+	auto &topCmd = fMessenger->DeclareProperty("top", fTopN, "Number of (particle, volume) rows in the report.");
+	topCmd.SetRange("top>=1");
+}
+// ============================================================================
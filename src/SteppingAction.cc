@@ -15,13 +15,22 @@
 
 #include "SteppingAction.hh"
 #include "DetectorConstruction.hh"
+#include "EarlyAbortPolicy.hh"
 #include "EventAction.hh"
+#include "ImportanceSplitting.hh"
+#include "LooperControl.hh"
+#include "RunAction.hh"
+#include "SlowEventMonitor.hh"
+#include "StepProfiler.hh"
+#include "TrackInformation.hh"
+#include "TrackKiller.hh"
 
 #include "G4AnalysisManager.hh"
 #include "G4LogicalVolume.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4RunManager.hh"
 #include "G4Step.hh"
+#include "G4SteppingManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4Track.hh"
 #include "G4VPhysicalVolume.hh"
@@ -53,14 +62,23 @@
 SteppingAction::SteppingAction(const DetectorConstruction *detectorConstruction)
 	: fDetectorConstruction(detectorConstruction)
 {
+	fTrackKiller = new TrackKiller(detectorConstruction);
+	fImportanceSplitting = new ImportanceSplitting(detectorConstruction);
+	fProfiler = StepProfiler::Instance();
+	fSlowEventMonitor = SlowEventMonitor::Instance();
+	fLooperControl = LooperControl::Instance();
 }
 // ----------------------------------------------------------------------------
 /**
  * @brief Destructor
  *
- * No custom cleanup is needed for this class.
+ * Releases the track killer and the importance splitting.
  */
-SteppingAction::~SteppingAction() {}
+SteppingAction::~SteppingAction()
+{
+	delete fTrackKiller;
+	delete fImportanceSplitting;
+}
 
 // ============================================================================
 // User Stepping Action
@@ -86,11 +104,77 @@ SteppingAction::~SteppingAction() {}
  */
 void SteppingAction::UserSteppingAction(const G4Step *step)
 {
+#ifdef ATS_STEP_PROFILER
+	// Charge the wall time of this step to its (particle, volume) pair (opt-in)
+	if (fProfiler->IsEnabled())
+	{
+		fProfiler->RecordStep(step);
+	}
+#endif
+
 	const G4Track *track = step->GetTrack();
 	G4AnalysisManager *analysisManager = G4AnalysisManager::Instance();
 
 	G4ParticleDefinition *particle = track->GetDefinition();
 
+	// Per-thread event action (cached: the user action never changes during a run)
+	if (!fEventAction)
+	{
+		fEventAction = dynamic_cast<EventAction *>(const_cast<G4UserEventAction *>(
+			G4RunManager::GetRunManager()->GetUserEventAction()));
+	}
+
+	if (fEventAction)
+	{
+		fEventAction->CountStep();
+	}
+
+	// Steps per species, recorded with slow events (opt-in)
+	if (fSlowEventMonitor->IsEnabled())
+	{
+		fSlowEventMonitor->CountStep(particle);
+	}
+
+	// Tracks killed by transportation as loopers: tally them, and keep looping muons out of the stop scoring
+	G4bool looper = fLooperControl->IsLooperKill(step);
+	if (looper)
+	{
+		G4bool isMuon = particle->GetParticleName() == "mu+" || particle->GetParticleName() == "mu-";
+		auto runAction = const_cast<RunAction *>(static_cast<const RunAction *>(
+			G4RunManager::GetRunManager()->GetUserRunAction()));
+		runAction->RecordLooper(track->GetKineticEnergy(), fLooperControl->GetTrackSeconds(), isMuon);
+
+		if (isMuon)
+		{
+			auto info = static_cast<TrackInformation *>(track->GetUserInformation());
+			if (!info)
+			{
+				info = new TrackInformation();
+				track->SetUserInformation(info);
+			}
+			info->SetLooperKilled(true);
+		}
+	}
+
+	// Drop low-energy neutrons, long-lived tracks and escaping tracks (never muons)
+	G4bool killed = fTrackKiller->Apply(step);
+
+	// Abort events whose production-target stage yields no muon precursor (opt-in)
+	if (fEventAction)
+	{
+		fEventAction->GetEarlyAbortPolicy()->ProcessStep(step);
+	}
+
+	if (killed || looper)
+		return;
+
+	// Split muons and pions moving toward the D-T cell, roulette those moving away (opt-in)
+	if (fImportanceSplitting->Apply(step, fpSteppingManager->GetfSecondary()))
+		return;
+
+	// Statistical weight of the track (1 unless importance splitting is enabled)
+	G4double weight = track->GetWeight();
+
 	// Tracking pions
 	// if (particle->GetParticleName() == "pi+" || particle->GetParticleName() == "pi-")
 	// {
@@ -102,17 +186,15 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 	if (particle->GetParticleName() != "mu+" && particle->GetParticleName() != "mu-")
 		return;
 
-	auto baseAction = const_cast<G4UserEventAction *>(
-		G4RunManager::GetRunManager()->GetUserEventAction());
-
-	auto eventAction = dynamic_cast<EventAction *>(baseAction);
-	if (eventAction)
+	if (fEventAction)
 	{
-		eventAction->SetKeepEvent(true);
+		fEventAction->SetKeepEvent(true);
 	}
 
-	// Case 1: muon was just created
-	if (track->GetCurrentStepNumber() == 1)
+	// Case 1: muon was just created (split clones start mid-flight and are skipped)
+	auto info = static_cast<const TrackInformation *>(track->GetUserInformation());
+	G4bool splitClone = info && info->IsSplitClone();
+	if (track->GetCurrentStepNumber() == 1 && !splitClone)
 	{
 		// G4cout << "[DEBUG] About to fill histogram for track ID "
 		// 	   << track->GetTrackID() << ", particle: " << track->GetParticleDefinition()
@@ -122,7 +204,13 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 
 		G4double energy = track->GetKineticEnergy();
 		// G4cout << "[DEBUG] FillH1 ID=0, energy=" << energy << G4endl;
-		analysisManager->FillH1(0, energy / MeV); // Histogram 0: MuonEnergy
+		analysisManager->FillH1(0, energy / MeV, weight); // Histogram 0: MuonEnergy
+
+		// Credit the muon to its primary (several primaries per event)
+		if (fEventAction)
+		{
+			fEventAction->RecordMuon(track->GetTrackID(), weight);
+		}
 	}
 
 	// Case 2: muon is about to stop (track status is fStopAndKill)
@@ -130,12 +218,12 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 	{
 		G4ThreeVector pos = track->GetPosition();
 		G4double r = std::sqrt(pos.x() * pos.x() + pos.y() * pos.y());
-		analysisManager->FillH1(3, r / mm); // Histogram ID 3: radial distance from beamline
+		analysisManager->FillH1(3, r / mm, weight); // Histogram ID 3: radial distance from beamline
 		// G4cout << "[DEBUG] FillH1 ID=3, rStop=" << r / mm << " mm" << G4endl;
 
 		G4double zStop = pos.z();
 		// G4cout << "[DEBUG] FillH1 ID=1, zStop=" << zStop << G4endl;
-		analysisManager->FillH1(1, zStop / mm); // Histogram 1: MuonStopZ
+		analysisManager->FillH1(1, zStop / mm, weight); // Histogram 1: MuonStopZ
 
 		// Get volume muon stopped in
 		G4LogicalVolume *vol = step->GetPreStepPoint()->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
@@ -171,7 +259,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 		if (targetIndex >= 0)
 		{
 			// G4cout << "[DEBUG] FillH1 ID=2, targetIndex=" << targetIndex << G4endl;
-			analysisManager->FillH1(2, targetIndex); // Histogram 2: MuonStopTarget
+			analysisManager->FillH1(2, targetIndex, weight); // Histogram 2: MuonStopTarget
 		}
 
 		// NEW: If stopped in D-T gas region
@@ -181,8 +269,13 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 				   << " | Z = " << zStop / mm << " mm"
 				   << " | R = " << r / mm << " mm" << G4endl;
 
-			analysisManager->FillH1(4, zStop / mm); // Histogram 4: MuonStopZ in D-T
-			analysisManager->FillH1(5, r / mm);		// Histogram 5: MuonStopR in D-T
+			analysisManager->FillH1(4, zStop / mm, weight); // Histogram 4: MuonStopZ in D-T
+			analysisManager->FillH1(5, r / mm, weight);	// Histogram 5: MuonStopR in D-T
+
+			if (fEventAction)
+			{
+				fEventAction->RecordMuonStopInDT(weight);
+			}
 		}
 	}
 }
@@ -0,0 +1,338 @@
+// ============================================================================
+//  File   : ThreadAffinity.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the worker-thread pinning policies and the CPU topology
+//           lookup they are based on.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "ThreadAffinity.hh"
+
+#include "G4AutoLock.hh"
+#include "G4GenericMessenger.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Constructor
+ */
+ThreadAffinity::ThreadAffinity(G4bool pinWorkers)
+	: fPinWorkers(pinWorkers)
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+ThreadAffinity::~ThreadAffinity()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Worker Hook
+// ============================================================================
+
+/**
+ * @brief Pins the calling worker thread, then sets up its random engine.
+ *
+ * Runs on the new worker before anything thread-local is allocated; the base
+ * class then clones the master engine, which is the first such allocation.
+ */
+void ThreadAffinity::SetupRNGEngine(const CLHEP::HepRandomEngine *masterEngine) const
+{
+	Cpu cpu;
+	G4int thread = G4Threading::G4GetThreadId();
+	if (GetCpu(thread, cpu))
+	{
+		if (Pin(cpu.id))
+		{
+			G4cout << "[Affinity] Worker " << thread << " pinned to CPU " << cpu.id
+				   << " (socket " << cpu.socket << ", core " << cpu.core << ")" << G4endl;
+		}
+		else
+		{
+			G4cerr << "[Affinity] Worker " << thread << " could not be pinned to CPU " << cpu.id << G4endl;
+		}
+	}
+
+	G4UserWorkerThreadInitialization::SetupRNGEngine(masterEngine);
+}
+
+// ============================================================================
+// Placement
+// ============================================================================
+
+/**
+ * @brief Returns the CPU of a worker thread in the current order.
+ *
+ * The order is built by the first worker after a change of the settings; the
+ * CPU is copied under the lock, so a later change cannot pull the order away.
+ */
+G4bool ThreadAffinity::GetCpu(G4int thread, Cpu &cpu) const
+{
+	G4AutoLock lock(&fMutex);
+	fWorkersStarted = true;
+	if (fPolicy == "none" || thread < 0)
+		return false;
+
+	BuildOrder();
+	if (fOrder.empty())
+		return false;
+
+	cpu = fOrder[static_cast<size_t>(thread) % fOrder.size()];
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Builds the CPU order of the active policy, once per setting.
+ *
+ * The topology is read from the process affinity mask, which the workers
+ * inherit from the master.
+ */
+void ThreadAffinity::BuildOrder() const
+{
+	if (fOrderBuilt)
+		return;
+	fOrderBuilt = true;
+	fOrder.clear();
+
+	std::vector<Cpu> cpus = ReadTopology();
+	if (cpus.empty())
+	{
+		G4cerr << "[Affinity] Thread pinning is not supported on this system; policy ignored" << G4endl;
+		return;
+	}
+
+	// Compact order: socket, then one CPU per physical core, then the SMT siblings
+	std::sort(cpus.begin(), cpus.end(), [](const Cpu &a, const Cpu &b) {
+		if (a.socket != b.socket)
+			return a.socket < b.socket;
+		if (a.sibling != b.sibling)
+			return a.sibling < b.sibling;
+		if (a.core != b.core)
+			return a.core < b.core;
+		return a.id < b.id;
+	});
+
+	if (fPolicy == "compact")
+	{
+		fOrder = cpus;
+	}
+	else if (fPolicy == "scatter")
+	{
+		// Round robin over the sockets, each in compact order
+		std::map<G4int, std::vector<Cpu>> sockets;
+		for (const auto &cpu : cpus)
+			sockets[cpu.socket].push_back(cpu);
+
+		for (size_t i = 0; fOrder.size() < cpus.size(); ++i)
+		{
+			for (const auto &socket : sockets)
+			{
+				if (i < socket.second.size())
+					fOrder.push_back(socket.second[i]);
+			}
+		}
+	}
+	else if (fPolicy == "list")
+	{
+		for (G4int id : ParseCpuList(fCpuList))
+		{
+			auto it = std::find_if(cpus.begin(), cpus.end(), [id](const Cpu &cpu) { return cpu.id == id; });
+			if (it != cpus.end())
+				fOrder.push_back(*it);
+			else
+				G4cerr << "[Affinity] CPU " << id << " is not available to this process; skipped" << G4endl;
+		}
+	}
+
+	if (fOrder.empty())
+	{
+		G4cerr << "[Affinity] No CPUs for policy \"" << fPolicy << "\"; threads are not pinned" << G4endl;
+		return;
+	}
+
+	G4int nSockets = 0;
+	for (const auto &cpu : fOrder)
+		nSockets = std::max(nSockets, cpu.socket + 1);
+	G4cout << "[Affinity] Policy: " << fPolicy << " | CPUs: " << fOrder.size()
+		   << " | Sockets: " << nSockets << G4endl;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the CPUs of the process affinity mask with their socket and core.
+ *
+ * Socket and core come from /sys/devices/system/cpu/cpu<N>/topology; missing
+ * entries (containers, unusual kernels) count as socket 0 with one core per CPU.
+ * Empty on systems without thread affinity (e.g. macOS).
+ */
+std::vector<ThreadAffinity::Cpu> ThreadAffinity::ReadTopology()
+{
+	std::vector<Cpu> cpus;
+
+#ifdef __linux__
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+		return cpus;
+
+	auto readValue = [](G4int id, const char *entry, G4int fallback) {
+		std::ifstream in("/sys/devices/system/cpu/cpu" + std::to_string(id) + "/topology/" + entry);
+		G4int value = fallback;
+		return (in >> value) ? value : fallback;
+	};
+
+	std::map<std::pair<G4int, G4int>, G4int> siblings; // (socket, core) -> CPUs seen so far
+	for (G4int id = 0; id < CPU_SETSIZE; ++id)
+	{
+		if (!CPU_ISSET(id, &allowed))
+			continue;
+
+		Cpu cpu;
+		cpu.id = id;
+		cpu.socket = std::max(0, readValue(id, "physical_package_id", 0));
+		cpu.core = readValue(id, "core_id", id);
+		cpu.sibling = siblings[{cpu.socket, cpu.core}]++;
+		cpus.push_back(cpu);
+	}
+#endif
+
+	return cpus;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Parses a CPU list such as "0-3,8,10-11" (spaces also separate entries).
+ */
+std::vector<G4int> ThreadAffinity::ParseCpuList(const G4String &list)
+{
+	std::vector<G4int> ids;
+
+	std::string text = list;
+	std::replace(text.begin(), text.end(), ',', ' ');
+	std::istringstream in(text);
+	for (std::string item; in >> item;)
+	{
+		size_t dash = item.find('-');
+		G4int first = std::atoi(item.substr(0, dash).c_str());
+		G4int last = dash == std::string::npos ? first : std::atoi(item.substr(dash + 1).c_str());
+		for (G4int id = first; id <= last; ++id)
+			ids.push_back(id);
+	}
+
+	return ids;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Pins the calling thread to one CPU.
+ */
+G4bool ThreadAffinity::Pin(G4int cpu)
+{
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+	(void)cpu;
+	return false;
+#endif
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Sets the placement policy.
+ */
+void ThreadAffinity::SetPolicy(const G4String &policy)
+{
+	fPolicy = policy;
+	PlacementChanged();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Sets the CPU list of the "list" policy.
+ */
+void ThreadAffinity::SetCpuList(const G4String &list)
+{
+	fCpuList = list;
+	PlacementChanged();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Discards the CPU order after a change of the settings.
+ *
+ * The next worker to start rebuilds it. Workers that are already running keep
+ * their CPU, and serial or sub-event runs have no workers to pin; both cases
+ * are reported.
+ */
+void ThreadAffinity::PlacementChanged()
+{
+	G4AutoLock lock(&fMutex);
+	fOrderBuilt = false;
+
+	if (!fPinWorkers)
+	{
+		if (fPolicy != "none")
+		{
+			G4Exception("ThreadAffinity", "NoWorkers", JustWarning,
+						"No event-level worker threads in this run mode (use --threads N); /ats/affinity/ is ignored.");
+		}
+	}
+	else if (fWorkersStarted)
+	{
+		G4Exception("ThreadAffinity", "WorkersStarted", JustWarning,
+					"The workers are already placed and keep their CPUs; the new placement only applies to "
+					"workers started later (issue /ats/affinity/ before /run/initialize).");
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Declares the /ats/affinity/ UI commands (master only, before /run/initialize).
+ */
+void ThreadAffinity::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/affinity/", "Worker thread pinning");
+
+	auto &policyCmd = fMessenger->DeclareMethod(
+		"policy", &ThreadAffinity::SetPolicy, "Worker placement: none | compact | scatter | list (before /run/initialize).");
+	policyCmd.SetParameterName("policy", false);
+	policyCmd.SetCandidates("none compact scatter list");
+	policyCmd.SetToBeBroadcasted(false);
+
+	auto &cpusCmd = fMessenger->DeclareMethod(
+		"cpus", &ThreadAffinity::SetCpuList, "CPUs of the list policy, thread k on the k-th entry (e.g. 0-7,16-23).");
+	cpusCmd.SetParameterName("cpus", false);
+	cpusCmd.SetToBeBroadcasted(false);
+}
+// ============================================================================
@@ -0,0 +1,30 @@
+// ============================================================================
+//  File   : TrackInformation.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the user track information used for per-track
+//           bookkeeping (importance-splitting clones).
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "TrackInformation.hh"
+
+#include "G4ios.hh"
+
+// ============================================================================
+// Print
+// ============================================================================
+
+/**
+ * @brief Prints the stored information (used by /tracking/verbose).
+ */
+void TrackInformation::Print() const
+{
+	G4cout << "[TrackInformation] SplitClone: " << (fSplitClone ? "yes" : "no")
+		   << " | RouletteKilled: " << (fRouletteKilled ? "yes" : "no")
+		   << " | LooperKilled: " << (fLooperKilled ? "yes" : "no")
+		   << " | MuonDecayProduct: " << (fMuonDecayProduct ? "yes" : "no") << G4endl;
+}
+// ============================================================================
@@ -0,0 +1,209 @@
+// ============================================================================
+//  File   : TrackKiller.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the configurable track killer. Low-energy neutrons,
+//           long-lived tracks and tracks escaping the apparatus are stopped,
+//           and each kill is tallied (count and kinetic energy) per run.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "TrackKiller.hh"
+#include "DetectorConstruction.hh"
+#include "MuonAncestry.hh"
+#include "RunAction.hh"
+
+#include "G4Box.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Neutron.hh"
+#include "G4RunManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Constructor
+ *
+ * Sets default thresholds (10 MeV neutrons, 1 us global time) and registers the
+ * UI commands. The killer stays disabled until /ats/killer/enable is issued.
+ */
+TrackKiller::TrackKiller(const DetectorConstruction *detectorConstruction)
+	: fDetectorConstruction(detectorConstruction),
+	  fNeutronEnergyThreshold(10. * MeV),
+	  fGlobalTimeThreshold(1. * microsecond)
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ *
+ * Releases the messenger and the lazily built envelope solid.
+ */
+TrackKiller::~TrackKiller()
+{
+	delete fMessenger;
+	delete fEnvelope;
+}
+
+// ============================================================================
+// Apply
+// ============================================================================
+
+/**
+ * @brief Applies the kill rules to the current step.
+ *
+ * Rules are evaluated in order (neutron energy, global time, world exit) and the
+ * first one that fires terminates the track with fStopAndKill. The kinetic energy
+ * at the post-step point is reported to RunAction for the per-run tally.
+ *
+ * @param step Pointer to the current G4Step.
+ * @return True if the track was killed.
+ */
+G4bool TrackKiller::Apply(const G4Step *step)
+{
+	if (!fEnabled)
+		return false;
+
+	G4Track *track = step->GetTrack();
+	if (track->GetTrackStatus() != fAlive)
+		return false;
+
+	const G4ParticleDefinition *particle = track->GetDefinition();
+	if (IsMuonChain(particle))
+		return false;
+
+	G4int reason = -1;
+	if (fNeutronEnergyThreshold > 0. && particle == G4Neutron::Definition() &&
+		track->GetKineticEnergy() < fNeutronEnergyThreshold)
+	{
+		reason = kNeutronEnergy;
+	}
+	else if (fGlobalTimeThreshold > 0. && track->GetGlobalTime() > fGlobalTimeThreshold)
+	{
+		reason = kGlobalTime;
+	}
+	else if (fWorldExitPolicy != "off")
+	{
+		// Only tracks currently in the world air (volume without a mother) are candidates
+		const G4VPhysicalVolume *postVolume = step->GetPostStepPoint()->GetPhysicalVolume();
+		G4bool neutralOnly = (fWorldExitPolicy == "neutral");
+		if (postVolume && postVolume->GetMotherLogical() == nullptr &&
+			(!neutralOnly || particle->GetPDGCharge() == 0.) &&
+			IsLeavingEnvelope(track->GetPosition(), track->GetMomentumDirection()))
+		{
+			reason = kWorldExit;
+		}
+	}
+
+	if (reason < 0)
+		return false;
+
+	track->SetTrackStatus(fStopAndKill);
+
+	auto runAction = const_cast<RunAction *>(
+		static_cast<const RunAction *>(G4RunManager::GetRunManager()->GetUserRunAction()));
+	if (runAction)
+	{
+		runAction->RecordKilledTrack(reason, track->GetKineticEnergy());
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Human-readable label for a kill reason.
+ */
+const char *TrackKiller::GetReasonName(G4int reason)
+{
+	switch (reason)
+	{
+	case kNeutronEnergy:
+		return "LowEnergyNeutron";
+	case kGlobalTime:
+		return "GlobalTime";
+	case kWorldExit:
+		return "WorldExit";
+	default:
+		return "Unknown";
+	}
+}
+
+// ============================================================================
+// Private Helpers
+// ============================================================================
+
+/**
+ * @brief Returns true for muons and their possible ancestors (MuonAncestry::IsMuonAncestor()).
+ */
+G4bool TrackKiller::IsMuonChain(const G4ParticleDefinition *particle) const
+{
+	return MuonAncestry::IsMuonAncestor(particle);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Checks whether a straight line can no longer reach the apparatus.
+ *
+ * A point outside the envelope whose ray misses the envelope box can only come
+ * back through scattering in air, which is negligible for the muon observables.
+ * This assumes a field-free world, which holds for all geometries except
+ * carbonStack (global 1 T field), where only the "neutral" policy is meaningful.
+ *
+ * @param pos Global position.
+ * @param dir Unit momentum direction.
+ * @return True if the track is outside the envelope and moving away from it.
+ */
+G4bool TrackKiller::IsLeavingEnvelope(const G4ThreeVector &pos, const G4ThreeVector &dir)
+{
+	if (!fEnvelope)
+	{
+		G4ThreeVector lo = fDetectorConstruction->GetEnvelopeMin();
+		G4ThreeVector hi = fDetectorConstruction->GetEnvelopeMax();
+		G4ThreeVector half = 0.5 * (hi - lo);
+		fEnvelopeCenter = 0.5 * (hi + lo);
+		fEnvelope = new G4Box("KillerEnvelope", half.x(), half.y(), half.z());
+	}
+
+	G4ThreeVector local = pos - fEnvelopeCenter;
+	if (fEnvelope->Inside(local) != kOutside)
+		return false;
+
+	return fEnvelope->DistanceToIn(local, dir) == kInfinity;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Declares the /ats/killer/ UI commands.
+ */
+void TrackKiller::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/killer/", "Track killer for irrelevant long-lived tracks");
+
+	fMessenger->DeclareProperty("enable", fEnabled, "Enable or disable the track killer.");
+
+	auto &energyCmd = fMessenger->DeclarePropertyWithUnit(
+		"neutronEnergy", "MeV", fNeutronEnergyThreshold,
+		"Kill neutrons below this kinetic energy (0 disables).");
+	energyCmd.SetRange("neutronEnergy>=0.");
+
+	auto &timeCmd = fMessenger->DeclarePropertyWithUnit(
+		"globalTime", "ns", fGlobalTimeThreshold,
+		"Kill non-muon-chain tracks older than this global time (0 disables).");
+	timeCmd.SetRange("globalTime>=0.");
+
+	auto &exitCmd = fMessenger->DeclareProperty(
+		"worldExit", fWorldExitPolicy,
+		"Kill tracks leaving the apparatus envelope: off | neutral | all.");
+	exitCmd.SetCandidates("off neutral all");
+}
+// ============================================================================
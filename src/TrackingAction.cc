@@ -14,15 +14,26 @@
 #include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4Track.hh"
+#include "G4TrackingManager.hh"
 #include "G4VProcess.hh"
 #include "G4ios.hh"
+#include "EventAction.hh"
+#include "EventDisplayWriter.hh"
+#include "LooperControl.hh"
 #include "RunAction.hh"
+#include "StepProfiler.hh"
+#include "TrackInformation.hh"
+#include "TrajectoryFilter.hh"
 
 // ----------------------------------------------------------------------------
 // Constructor
 // ----------------------------------------------------------------------------
 TrackingAction::TrackingAction()
 {
+	fProfiler = StepProfiler::Instance();
+	fLooperControl = LooperControl::Instance();
+	fTrajectoryFilter = new TrajectoryFilter();
+	fEventDisplayWriter = EventDisplayWriter::Instance();
 }
 
 // ----------------------------------------------------------------------------
@@ -30,6 +41,7 @@ TrackingAction::TrackingAction()
 // ----------------------------------------------------------------------------
 TrackingAction::~TrackingAction()
 {
+	delete fTrajectoryFilter;
 }
 
 // ----------------------------------------------------------------------------
@@ -47,6 +59,38 @@ TrackingAction::~TrackingAction()
 // ----------------------------------------------------------------------------
 void TrackingAction::PreUserTrackingAction(const G4Track *track)
 {
+#ifdef ATS_STEP_PROFILER
+	// Count the track and restart the step timer (opt-in)
+	if (fProfiler->IsEnabled())
+	{
+		fProfiler->StartTrack(track);
+	}
+#endif
+
+	// Start of the track, charged to it if it ends as a looper
+	fLooperControl->StartTrack();
+
+	// Store trajectories only for the muon chain (opt-in; the user's mode otherwise)
+	fpTrackingManager->SetStoreTrajectory(
+		fTrajectoryFilter->Select(track, fpTrackingManager->GetStoreTrajectory()));
+
+	// Creator process tag for the offline event display (opt-in)
+	if (fEventDisplayWriter->IsEnabled())
+	{
+		fEventDisplayWriter->RecordTrack(track);
+	}
+
+	// Primary this track descends from (several primaries per event only)
+	if (!fEventAction)
+	{
+		fEventAction = dynamic_cast<EventAction *>(const_cast<G4UserEventAction *>(
+			G4RunManager::GetRunManager()->GetUserEventAction()));
+	}
+	if (fEventAction)
+	{
+		fEventAction->RecordTrack(track->GetTrackID(), track->GetParentID());
+	}
+
 	const G4String &name = track->GetDefinition()->GetParticleName();
 
 	if (name == "mu+" || name == "mu-")
@@ -75,6 +119,14 @@ void TrackingAction::PostUserTrackingAction(const G4Track *track)
 {
 	const G4String &name = track->GetDefinition()->GetParticleName();
 
+	// Tag muon decay electrons so their trajectories are kept (opt-in)
+	fTrajectoryFilter->TagDecayProducts(track, fpTrackingManager->GimmeSecondaries());
+
+	// Tracks killed by Russian roulette or as loopers did not stop
+	auto info = static_cast<const TrackInformation *>(track->GetUserInformation());
+	if (info && (info->IsRouletteKilled() || info->IsLooperKilled()))
+		return;
+
 	if (name == "mu+" || name == "mu-")
 	{
 		G4ThreeVector stopPos = track->GetPosition();
@@ -91,7 +143,7 @@ void TrackingAction::PostUserTrackingAction(const G4Track *track)
 
 		if (runAction && runAction->GetMuonStoppingHistogram())
 		{
-			runAction->GetMuonStoppingHistogram()->Fill(z / mm);
+			runAction->GetMuonStoppingHistogram()->Fill(z / mm, track->GetWeight());
 		}
 	}
 }
@@ -0,0 +1,165 @@
+// ============================================================================
+//  File   : TrajectoryFilter.cc
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  Purpose: Implements the per-track selection of stored trajectories.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "TrajectoryFilter.hh"
+#include "TrackInformation.hh"
+
+#include "G4Electron.hh"
+#include "G4GenericMessenger.hh"
+#include "G4KaonMinus.hh"
+#include "G4KaonPlus.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4PionMinus.hh"
+#include "G4PionPlus.hh"
+#include "G4Positron.hh"
+#include "G4Proton.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+/**
+ * @brief Constructor
+ */
+TrajectoryFilter::TrajectoryFilter()
+{
+	DefineCommands();
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Destructor
+ */
+TrajectoryFilter::~TrajectoryFilter()
+{
+	delete fMessenger;
+}
+
+// ============================================================================
+// Selection
+// ============================================================================
+
+/**
+ * @brief Returns the trajectory storage mode for a new track.
+ *
+ * A non-zero mode in the tracking manager is the user's choice; a zero left
+ * behind by the filter keeps the last user mode, which is also restored when
+ * the filter is switched off.
+ *
+ * @param track Track about to be processed.
+ * @param currentMode Storage mode currently set in the tracking manager.
+ * @return Storage mode to set for this track.
+ */
+G4int TrajectoryFilter::Select(const G4Track *track, G4int currentMode)
+{
+	if (currentMode != 0 || !fSuppressed)
+		fUserMode = currentMode;
+
+	if (!fEnabled || fUserMode == 0)
+	{
+		fSuppressed = false;
+		return fUserMode;
+	}
+
+	G4bool selected = false;
+	if (track->GetKineticEnergy() >= fMinEnergy)
+	{
+		auto info = static_cast<const TrackInformation *>(track->GetUserInformation());
+		selected = IsChainParticle(track->GetDefinition()) ||
+				   (fDecayElectrons && info && info->IsMuonDecayProduct());
+	}
+
+	fSuppressed = !selected;
+	return selected ? fUserMode : 0;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Tags the e+/e- produced by the decay of a finished muon.
+ *
+ * Free decays are recognised by their creator process type. Decay in orbit of
+ * a bound mu- is produced by the capture-at-rest process, which also emits
+ * keV Auger electrons; only its electrons above 1 MeV are taken.
+ *
+ * @param track Muon track that just ended.
+ * @param secondaries Secondaries produced by the track.
+ */
+void TrajectoryFilter::TagDecayProducts(const G4Track *track, const G4TrackVector *secondaries) const
+{
+	if (!fEnabled || !fDecayElectrons || !secondaries)
+		return;
+
+	const G4ParticleDefinition *particle = track->GetDefinition();
+	if (particle != G4MuonPlus::Definition() && particle != G4MuonMinus::Definition())
+		return;
+
+	for (G4Track *secondary : *secondaries)
+	{
+		const G4ParticleDefinition *product = secondary->GetDefinition();
+		if (product != G4Electron::Definition() && product != G4Positron::Definition())
+			continue;
+
+		const G4VProcess *creator = secondary->GetCreatorProcess();
+		if (!creator)
+			continue;
+
+		G4bool decay = creator->GetProcessType() == fDecay ||
+					   (creator->GetProcessName() == "muMinusCaptureAtRest" && secondary->GetKineticEnergy() > 1. * MeV);
+		if (!decay)
+			continue;
+
+		auto info = static_cast<TrackInformation *>(secondary->GetUserInformation());
+		if (!info)
+		{
+			info = new TrackInformation();
+			secondary->SetUserInformation(info);
+		}
+		info->SetMuonDecayProduct(true);
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns true for protons, charged pions, charged kaons and muons.
+ */
+G4bool TrajectoryFilter::IsChainParticle(const G4ParticleDefinition *particle) const
+{
+	return particle == G4Proton::Definition() ||
+		   particle == G4PionPlus::Definition() || particle == G4PionMinus::Definition() ||
+		   particle == G4KaonPlus::Definition() || particle == G4KaonMinus::Definition() ||
+		   particle == G4MuonPlus::Definition() || particle == G4MuonMinus::Definition();
+}
+
+// ============================================================================
+// UI Commands
+// ============================================================================
+
+/**
+ * @brief Declares the /ats/traj/ UI commands.
+ */
+void TrajectoryFilter::DefineCommands()
+{
+	fMessenger = new G4GenericMessenger(this, "/ats/traj/", "Selective trajectory storage");
+
+	fMessenger->DeclareProperty("select", fEnabled,
+								"Store trajectories only for protons, pions, kaons, muons (and muon decay e+/e-).");
+
+	fMessenger->DeclareProperty("decayElectrons", fDecayElectrons,
+								"Also store trajectories of muon decay electrons and positrons.");
+
+	auto &minEnergyCmd = fMessenger->DeclarePropertyWithUnit("minEnergy", "MeV", fMinEnergy,
+															 "Tracks below this kinetic energy get no trajectory.");
+	minEnergyCmd.SetRange("minEnergy>=0.");
+}
+// ============================================================================
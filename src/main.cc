@@ -11,17 +11,40 @@
 // ============================================================================
 
 #include "G4RunManager.hh"
+#include "G4RunManagerFactory.hh"
+#include "G4StateManager.hh"
 #include "G4UIExecutive.hh"
 #include "G4UImanager.hh"
 #include "G4VisExecutive.hh"
 #include "QGSP_BERT.hh"
 
+#include "ActionInitialization.hh"
 #include "DetectorConstruction.hh"
-#include "EventAction.hh"
-#include "PrimaryGeneratorAction.hh"
-#include "RunAction.hh"
-#include "SteppingAction.hh"
-#include "TrackingAction.hh"
+#include "JobLauncher.hh"
+#include "RunInterrupt.hh"
+#include "SubEventParallelism.hh"
+#include "ThreadAffinity.hh"
+
+#include <cstdlib>
+#include <memory>
+
+/**
+ * @brief Prints the command-line help.
+ */
+static void PrintUsage()
+{
+	G4cout << "Usage: active_target_sim [macro] [options]\n"
+		   << "  (no arguments)    Interactive session with visualization\n"
+		   << "  macro             Batch mode: execute the macro\n"
+		   << "  -n <events>       Run <events> events after the macro (/run/beamOn)\n"
+		   << "  --jobs <N>        Split the events over N processes and merge their outputs\n"
+		   << "  --seed <S>        Master seed of the job random streams (default: 12345)\n"
+		   << "  --retries <R>     Restarts of a crashed job (default: 2)\n"
+		   << "  --subevent <T>    Sub-event parallel mode: ship the shower to other threads in bundles\n"
+		   << "                    of T tracks (Geant4 11.2+, multithreaded builds)\n"
+		   << "  --threads <N>     Multithreaded run with N workers, pinned with /ats/affinity/\n"
+		   << "                    (with --subevent: its worker threads, default all cores)" << G4endl;
+}
 
 /**
  * @brief Entry point of the ActiveTargetSim simulation.
@@ -33,12 +56,73 @@
  * - Visualization engine
  * - Interactive or batch execution
  *
+ * With --jobs N, the process forks N jobs before any Geant4 object exists
+ * (see JobLauncher); every job then runs the setup below with its own seeds.
+ * With --subevent T the run manager is a sub-event parallel one (see
+ * SubEventParallelism), with --threads N alone an event-level multithreaded
+ * one whose workers can be pinned (see ThreadAffinity); the default is serial.
+ *
  * @param argc Argument count
- * @param argv Argument values (used to check for interactive mode)
+ * @param argv Argument values (see PrintUsage)
  * @return Exit code
  */
 int main(int argc, char **argv)
 {
+	// =========================================================================
+	// Command Line
+	// =========================================================================
+	G4String macro;
+	G4long nEvents = -1;
+	G4int nJobs = 0;
+	G4long masterSeed = 12345;
+	G4int maxRetries = 2;
+	G4int subEventTracks = 0;
+	G4int nThreads = 0;
+	for (G4int i = 1; i < argc; ++i)
+	{
+		G4String arg = argv[i];
+		auto next = [&]() -> const char * { return i + 1 < argc ? argv[++i] : ""; };
+
+		if (arg == "-n")
+			nEvents = std::atol(next());
+		else if (arg == "--jobs")
+			nJobs = std::atoi(next());
+		else if (arg == "--seed")
+			masterSeed = std::atol(next());
+		else if (arg == "--retries")
+			maxRetries = std::atoi(next());
+		else if (arg == "--subevent")
+			subEventTracks = std::atoi(next());
+		else if (arg == "--threads")
+			nThreads = std::atoi(next());
+		else if (!arg.empty() && arg[0] != '-' && macro.empty())
+			macro = arg;
+		else
+		{
+			PrintUsage();
+			return arg == "--help" ? 0 : 2;
+		}
+	}
+
+	if (nJobs > 0 && (nEvents <= 0 || masterSeed <= 0 || masterSeed > 2147483647))
+	{
+		G4cerr << "--jobs needs -n <events> > 0 and a seed in [1, 2147483647]" << G4endl;
+		return 2;
+	}
+
+	// =========================================================================
+	// Job Fan-Out (parent waits here, children continue)
+	// =========================================================================
+	std::unique_ptr<JobLauncher> launcher;
+	if (nJobs > 0)
+	{
+		launcher = std::make_unique<JobLauncher>(nJobs, nEvents, masterSeed, maxRetries);
+		if (launcher->Fork() < 0)
+		{
+			return launcher->GetExitCode();
+		}
+	}
+
 	// =========================================================================
 	// UI Setup
 	// =========================================================================
@@ -52,7 +136,43 @@ int main(int argc, char **argv)
 	// =========================================================================
 	// Run Manager
 	// =========================================================================
-	auto *runManager = new G4RunManager();
+	G4RunManager *runManager = nullptr;
+	std::unique_ptr<ThreadAffinity> unusedAffinity; // /ats/affinity/ commands without workers to pin
+	if (subEventTracks > 0)
+	{
+		// Heavy events split across threads (the run manager type cannot change later)
+		runManager = SubEventParallelism::CreateRunManager(nThreads, subEventTracks);
+		if (!runManager)
+		{
+			delete ui;
+			return 2;
+		}
+	}
+	else if (nThreads > 0)
+	{
+#ifdef G4MULTITHREADED
+		// Event-level MT; ThreadAffinity pins each worker before it allocates anything
+		runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::MTOnly, nThreads);
+		runManager->SetUserInitialization(new ThreadAffinity());
+#else
+		G4cerr << "--threads needs Geant4 built with multithreading" << G4endl;
+		delete ui;
+		return 2;
+#endif
+	}
+	else
+	{
+		runManager = new G4RunManager();
+	}
+
+	// Serial and sub-event runs: the same macros work, /ats/affinity/ only warns
+	if (nThreads <= 0 || subEventTracks > 0)
+	{
+		unusedAffinity = std::make_unique<ThreadAffinity>(false);
+	}
+
+	// Ctrl-C / SIGTERM end the current run cleanly (output is still merged and written)
+	RunInterrupt::Install();
 
 	// =========================================================================
 	// Detector Setup (includes magnetic field and scoring volumes)
@@ -70,19 +190,8 @@ int main(int argc, char **argv)
 	// =========================================================================
 	// Register User Actions
 	// =========================================================================
-	runManager->SetUserAction(new EventAction());
-
-	// Primary generator (defines the particle beam)
-	runManager->SetUserAction(new PrimaryGeneratorAction());
-
-	// Actions at the start and end of each simulation run
-	runManager->SetUserAction(new RunAction());
-
-	// Step-level user actions (e.g., scoring)
-	runManager->SetUserAction(new SteppingAction(detector));
-
-	// Register user-defined tracking action (e.g., muon birth info)
-	runManager->SetUserAction(new TrackingAction());
+	// Event, primary, run, stepping, tracking and stacking actions (one set per thread)
+	runManager->SetUserInitialization(new ActionInitialization(detector));
 
 	// =========================================================================
 	// Visualization Engine
@@ -98,7 +207,12 @@ int main(int argc, char **argv)
 	// =========================================================================
 	// Execution Mode
 	// =========================================================================
-	if (ui)
+	if (launcher)
+	{
+		// ----- Job of a --jobs fan-out -----
+		launcher->RunJob(UImanager, macro);
+	}
+	else if (ui)
 	{
 		// ----- Interactive Mode -----
 		// UImanager->ApplyCommand("/control/execute vis.mac"); // Load viewer & draw geometry
@@ -109,13 +223,28 @@ int main(int argc, char **argv)
 	else
 	{
 		// ----- Batch Mode -----
-		UImanager->ApplyCommand("/run/beamOn 10"); // Default batch execution (adjustable via script)
+		// Execute the macro given on the command line (e.g. run.mac, vis_offscreen.mac)
+		if (!macro.empty())
+		{
+			UImanager->ApplyCommand("/control/execute " + macro);
+		}
+
+		// Then -n events, if given
+		if (nEvents >= 0)
+		{
+			if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_PreInit)
+			{
+				UImanager->ApplyCommand("/run/initialize");
+			}
+			UImanager->ApplyCommand("/run/beamOn " + std::to_string(nEvents));
+		}
 	}
 
 	// =========================================================================
 	// Cleanup
 	// =========================================================================
 	delete visManager;
+	unusedAffinity.reset(); // its commands go before the UI manager
 	delete runManager;
 
 	return 0;
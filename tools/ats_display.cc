@@ -0,0 +1,341 @@
+// ============================================================================
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  File   : ats_display.cc
+//  Purpose: Offline viewer for the .atsd event-display files written with
+//           /ats/display/enable. Lists the stored muon events and exports
+//           selected events to VRML 2.0 for any standard 3D viewer.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "EventDisplayFormat.hh"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+// ============================================================================
+// File Contents
+// ============================================================================
+
+/// One trajectory with its decoded points [mm].
+struct Trajectory
+{
+	std::int32_t trackID = 0;
+	std::int32_t parentID = 0;
+	std::int32_t pdg = 0;
+	std::uint8_t processTag = EventDisplayFormat::kOther;
+	std::vector<float> points; ///< x, y, z per point
+};
+
+/// One stored event.
+struct Event
+{
+	std::int32_t runID = 0;
+	std::int32_t eventID = 0;
+	std::vector<Trajectory> trajectories;
+};
+
+/// Command-line options.
+struct Options
+{
+	std::vector<std::string> inputs;
+	std::string vrml;
+	int runID = -1;	  ///< -1: any run
+	int eventID = -1; ///< -1: every event
+	bool list = false;
+	bool muonsOnly = false;
+};
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Reads one trivially copyable value (little-endian); returns false at end of file.
+ */
+template <typename T>
+bool Get(std::istream &in, T &value)
+{
+	if (!in.read(reinterpret_cast<char *>(&value), sizeof(T)))
+		return false;
+	value = EventDisplayFormat::ToFileOrder(value);
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Reads every event of a .atsd file, undoing the delta encoding.
+ * @return False if the file cannot be opened or has a wrong header.
+ */
+bool ReadFile(const std::string &fileName, std::vector<Event> &events)
+{
+	std::ifstream in(fileName, std::ios::binary);
+	if (!in)
+	{
+		std::cerr << "Cannot open " << fileName << "\n";
+		return false;
+	}
+
+	char magic[4];
+	std::uint32_t version = 0;
+	if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, EventDisplayFormat::kMagic, sizeof(magic)) != 0 ||
+		!Get(in, version) || version != EventDisplayFormat::kVersion)
+	{
+		std::cerr << fileName << " is not an event-display file (version " << EventDisplayFormat::kVersion << ")\n";
+		return false;
+	}
+
+	Event event;
+	while (Get(in, event.runID) && Get(in, event.eventID))
+	{
+		std::uint32_t nTrajectories = 0;
+		Get(in, nTrajectories);
+		event.trajectories.assign(nTrajectories, Trajectory());
+
+		for (auto &trajectory : event.trajectories)
+		{
+			std::uint32_t nPoints = 0;
+			Get(in, trajectory.trackID);
+			Get(in, trajectory.parentID);
+			Get(in, trajectory.pdg);
+			Get(in, trajectory.processTag);
+			Get(in, nPoints);
+
+			trajectory.points.resize(3 * nPoints);
+			in.read(reinterpret_cast<char *>(trajectory.points.data()), trajectory.points.size() * sizeof(float));
+			for (float &value : trajectory.points)
+				value = EventDisplayFormat::ToFileOrder(value);
+			for (std::size_t i = 3; i < trajectory.points.size(); ++i)
+				trajectory.points[i] += trajectory.points[i - 3];
+		}
+
+		if (!in)
+		{
+			std::cerr << fileName << ": truncated event " << event.eventID << " ignored\n";
+			break;
+		}
+		events.push_back(std::move(event));
+		event = Event();
+	}
+	return true;
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+/**
+ * @brief Returns true for mu+ and mu-.
+ */
+bool IsMuon(std::int32_t pdg)
+{
+	return pdg == 13 || pdg == -13;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the display colour of a particle (same scheme as vis.mac).
+ */
+const char *GetColour(std::int32_t pdg)
+{
+	switch (pdg)
+	{
+	case 22:
+		return "0 1 0"; // gamma: green
+	case 2212:
+		return "1 0 0"; // proton: red
+	case 11:
+		return "0 0 1"; // e-: blue
+	case -11:
+		return "0.5 0.5 1"; // e+: light blue
+	case 2112:
+		return "1 1 0"; // neutron: yellow
+	case 13:
+		return "1 0 1"; // mu-: magenta
+	case -13:
+		return "0 1 1"; // mu+: cyan
+	case 211:
+	case -211:
+		return "1 0.5 0"; // pions: orange
+	default:
+		return "0.7 0.7 0.7";
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints one line per event and the trajectory count per particle.
+ */
+void PrintList(const std::vector<const Event *> &events)
+{
+	for (const Event *event : events)
+	{
+		std::map<std::int32_t, int> perParticle;
+		std::size_t nPoints = 0;
+		for (const auto &trajectory : event->trajectories)
+		{
+			++perParticle[trajectory.pdg];
+			nPoints += trajectory.points.size() / 3;
+		}
+
+		std::cout << "Run " << event->runID << " | Event " << event->eventID
+				  << " | Trajectories: " << event->trajectories.size()
+				  << " | Points: " << nPoints << " |";
+		for (const auto &[pdg, count] : perParticle)
+			std::cout << " " << pdg << ":" << count;
+		std::cout << "\n";
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Writes the selected events as VRML 2.0 line sets (one Shape per trajectory).
+ *
+ * Track ID, particle and creator are written as a comment above each shape.
+ */
+bool WriteVrml(const std::string &fileName, const std::vector<const Event *> &events, bool muonsOnly)
+{
+	std::ofstream out(fileName);
+	if (!out)
+	{
+		std::cerr << "Cannot write " << fileName << "\n";
+		return false;
+	}
+
+	out << "#VRML V2.0 utf8\n"
+		<< "# ActiveTargetSim event display, coordinates in mm\n";
+
+	std::size_t nShapes = 0;
+	for (const Event *event : events)
+	{
+		out << "# Run " << event->runID << " Event " << event->eventID << "\n";
+		for (const auto &trajectory : event->trajectories)
+		{
+			std::size_t nPoints = trajectory.points.size() / 3;
+			if (nPoints < 2 || (muonsOnly && !IsMuon(trajectory.pdg)))
+				continue;
+
+			out << "# track " << trajectory.trackID << " parent " << trajectory.parentID
+				<< " pdg " << trajectory.pdg
+				<< " creator " << EventDisplayFormat::GetProcessTagName(trajectory.processTag) << "\n"
+				<< "Shape {\n"
+				<< "  appearance Appearance { material Material { emissiveColor " << GetColour(trajectory.pdg) << " } }\n"
+				<< "  geometry IndexedLineSet {\n"
+				<< "    coord Coordinate { point [\n";
+			for (std::size_t i = 0; i < nPoints; ++i)
+			{
+				out << "      " << trajectory.points[3 * i] << " " << trajectory.points[3 * i + 1] << " "
+					<< trajectory.points[3 * i + 2] << ",\n";
+			}
+			out << "    ] }\n"
+				<< "    coordIndex [";
+			for (std::size_t i = 0; i < nPoints; ++i)
+				out << " " << i;
+			out << " -1 ]\n"
+				<< "  }\n"
+				<< "}\n";
+			++nShapes;
+		}
+	}
+
+	std::cout << "[ats_display] Wrote " << nShapes << " trajectories of " << events.size()
+			  << " event(s) to " << fileName << "\n";
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the command-line help.
+ */
+void PrintUsage()
+{
+	std::cout << "Usage: ats_display <file.atsd>... [options]\n"
+			  << "  --list              List the stored events (default without --vrml)\n"
+			  << "  --event <run>:<id>  Select one event (or <id> for any run)\n"
+			  << "  --vrml <file.wrl>   Export the selected events to VRML 2.0\n"
+			  << "  --muons             Export muon trajectories only\n";
+}
+} // namespace
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char **argv)
+{
+	Options opt;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		auto next = [&]() -> std::string { return i + 1 < argc ? argv[++i] : ""; };
+
+		if (arg == "--list")
+			opt.list = true;
+		else if (arg == "--vrml")
+			opt.vrml = next();
+		else if (arg == "--muons")
+			opt.muonsOnly = true;
+		else if (arg == "--event")
+		{
+			std::string value = next();
+			auto colon = value.find(':');
+			if (colon != std::string::npos)
+			{
+				opt.runID = std::atoi(value.substr(0, colon).c_str());
+				opt.eventID = std::atoi(value.substr(colon + 1).c_str());
+			}
+			else
+			{
+				opt.eventID = std::atoi(value.c_str());
+			}
+		}
+		else if (!arg.empty() && arg[0] != '-')
+			opt.inputs.push_back(arg);
+		else
+		{
+			PrintUsage();
+			return arg == "--help" ? 0 : 2;
+		}
+	}
+
+	if (opt.inputs.empty())
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	std::vector<Event> events;
+	for (const auto &input : opt.inputs)
+	{
+		if (!ReadFile(input, events))
+			return 1;
+	}
+
+	std::vector<const Event *> selected;
+	for (const auto &event : events)
+	{
+		if ((opt.runID < 0 || event.runID == opt.runID) && (opt.eventID < 0 || event.eventID == opt.eventID))
+			selected.push_back(&event);
+	}
+
+	if (opt.list || opt.vrml.empty())
+		PrintList(selected);
+
+	if (!opt.vrml.empty())
+	{
+		if (selected.empty())
+		{
+			std::cerr << "No event matches the selection\n";
+			return 1;
+		}
+		return WriteVrml(opt.vrml, selected, opt.muonsOnly) ? 0 : 1;
+	}
+	return 0;
+}
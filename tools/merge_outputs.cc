@@ -0,0 +1,577 @@
+// ============================================================================
+//  Project: ActiveTargetSim - Muon-Catalyzed Fusion Simulation Toolkit
+//  File   : merge_outputs.cc
+//  Purpose: Merges many per-job output files (histograms and ntuples) with a
+//           parallel tree reduction, checks binning and run configurations,
+//           and writes the summary PDFs of the merged histograms.
+//
+//  Author : Mohammadreza Zakeri (Zaki)
+//  Email  : m.zakeri@eku.edu
+//  Created: 2026-10-16
+// ============================================================================
+
+#include "TCanvas.h"
+#include "TChain.h"
+#include "TClass.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TKey.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// ============================================================================
+// Merge State
+// ============================================================================
+
+/// One histogram being merged, with the first file it came from.
+struct Entry
+{
+	std::unique_ptr<TH1> hist;
+	std::string source;
+};
+
+/// Histograms merged by one thread (one node of the reduction tree).
+struct Partial
+{
+	std::map<std::string, Entry> hists;
+	std::vector<std::string> order; ///< first-seen order, kept in the output
+};
+
+/// Run record (JSON sidecar) of one input file.
+struct Record
+{
+	bool found = false;
+	std::string configuration; ///< settings that must agree between inputs
+	long long requested = 0;
+	long long completed = 0;
+};
+
+/// Command-line options.
+struct Options
+{
+	std::vector<std::string> inputs;
+	std::string output = "merged_output.root";
+	std::string pdfDir;
+	unsigned jobs = 0; ///< 0: hardware concurrency
+	bool force = false;
+};
+
+/// Axis ranges of the summary plots (same as Hists/convert_histograms.C).
+const std::map<std::string, std::pair<double, double>> kPlotRanges = {
+	{"MuonEnergy", {0, 30}},	// MeV
+	{"MuonStopZ", {-120, -70}}, // mm
+	{"MuonStopTarget", {0, 5}}, // target indices
+	{"MuonStopRadius", {0, 10}} // mm
+};
+
+/// Histograms drawn as summary PDFs.
+const std::vector<std::string> kPlotNames = {"MuonEnergy", "MuonStopZ", "MuonStopTarget",
+											 "MuonStopRadius", "muonStopZ_DT", "muonStopR_DT"};
+
+/// UI command prefixes that may differ between jobs of one campaign.
+const std::vector<std::string> kPerJobCommands = {"/ats/output/", "/random/", "/ats/seed/", "/run/beamOn",
+												  "/ats/checkpoint/", "/ats/monitor/", "/control/"};
+
+std::mutex gLogMutex;
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints a message from any thread.
+ */
+void Log(const std::string &message)
+{
+	std::lock_guard<std::mutex> lock(gLogMutex);
+	std::cerr << message << "\n";
+}
+
+// ============================================================================
+// Run Records
+// ============================================================================
+
+/**
+ * @brief Returns the raw JSON value following "key": (string contents or number).
+ *
+ * Enough for the records written by OutputManager; not a general JSON parser.
+ */
+std::string FindValue(const std::string &json, const std::string &key)
+{
+	auto pos = json.find("\"" + key + "\":");
+	if (pos == std::string::npos)
+		return "";
+	pos = json.find_first_not_of(" \n", pos + key.size() + 3);
+	if (pos == std::string::npos)
+		return "";
+	if (json[pos] == '"')
+	{
+		std::string value;
+		for (++pos; pos < json.size() && json[pos] != '"'; ++pos)
+		{
+			if (json[pos] == '\\' && pos + 1 < json.size())
+				++pos;
+			value += json[pos];
+		}
+		return value;
+	}
+	auto end = json.find_first_of(",}\n", pos);
+	return json.substr(pos, end - pos);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Returns the strings of the JSON array "key": [...].
+ */
+std::vector<std::string> FindStrings(const std::string &json, const std::string &key)
+{
+	std::vector<std::string> values;
+	auto pos = json.find("\"" + key + "\":");
+	if (pos == std::string::npos)
+		return values;
+	auto end = json.find(']', pos);
+	pos = json.find('[', pos);
+	while (pos < end)
+	{
+		auto open = json.find('"', pos);
+		if (open == std::string::npos || open > end)
+			break;
+		std::string value;
+		auto i = open + 1;
+		for (; i < json.size() && json[i] != '"'; ++i)
+		{
+			if (json[i] == '\\' && i + 1 < json.size())
+				++i;
+			value += json[i];
+		}
+		values.push_back(value);
+		pos = i + 1;
+		end = json.find(']', pos);
+	}
+	return values;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Reads the run record <name>.json of an input file <name>.root.
+ *
+ * The configuration string combines geometry, Geant4 version, git revision
+ * and the UI commands of the session minus those that legitimately differ
+ * per job (output name, seeds, event count, checkpoints, monitor).
+ */
+Record ReadRecord(const std::string &input)
+{
+	Record record;
+	std::string base = input;
+	if (base.size() > 5 && base.compare(base.size() - 5, 5, ".root") == 0)
+		base.resize(base.size() - 5);
+
+	std::ifstream in(base + ".json");
+	if (!in)
+		return record;
+
+	std::stringstream buffer;
+	buffer << in.rdbuf();
+	const std::string json = buffer.str();
+
+	record.found = true;
+	record.requested = std::atoll(FindValue(json, "requested").c_str());
+	record.completed = std::atoll(FindValue(json, "completed").c_str());
+
+	std::ostringstream configuration;
+	configuration << "geometry=" << FindValue(json, "geometry") << "\n"
+				  << "geant4=" << FindValue(json, "geant4") << "\n"
+				  << "git=" << FindValue(json, "gitHash") << "\n";
+	for (const auto &command : FindStrings(json, "commands"))
+	{
+		bool perJob = false;
+		for (const auto &prefix : kPerJobCommands)
+			perJob = perJob || command.compare(0, prefix.size(), prefix) == 0;
+		if (!perJob)
+			configuration << command << "\n";
+	}
+	record.configuration = configuration.str();
+	return record;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief FNV-1a hash of a configuration, printed as 16 hex digits.
+ */
+std::string Hash(const std::string &text)
+{
+	std::uint64_t hash = 1469598103934665603ULL;
+	for (unsigned char c : text)
+	{
+		hash ^= c;
+		hash *= 1099511628211ULL;
+	}
+	std::ostringstream out;
+	out << std::hex << std::setw(16) << std::setfill('0') << hash;
+	return out.str();
+}
+
+// ============================================================================
+// Histogram Merging
+// ============================================================================
+
+/**
+ * @brief Returns true if two histograms have the same type and binning.
+ */
+bool SameBinning(const TH1 *a, const TH1 *b)
+{
+	if (a->IsA() != b->IsA() || a->GetDimension() != b->GetDimension())
+		return false;
+
+	const TAxis *axes[2][3] = {{a->GetXaxis(), a->GetYaxis(), a->GetZaxis()},
+							   {b->GetXaxis(), b->GetYaxis(), b->GetZaxis()}};
+	for (int d = 0; d < a->GetDimension(); ++d)
+	{
+		const TAxis *x = axes[0][d];
+		const TAxis *y = axes[1][d];
+		if (x->GetNbins() != y->GetNbins())
+			return false;
+		for (int i = 1; i <= x->GetNbins() + 1; ++i)
+		{
+			double edge = x->GetBinLowEdge(i);
+			if (std::abs(edge - y->GetBinLowEdge(i)) > 1e-9 * (std::abs(edge) + 1.))
+				return false;
+		}
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Adds one histogram to a partial sum, checking its binning.
+ * @return False on a binning mismatch (the histogram is then not added).
+ */
+bool Add(Partial &partial, const std::string &name, std::unique_ptr<TH1> hist, const std::string &source)
+{
+	auto it = partial.hists.find(name);
+	if (it == partial.hists.end())
+	{
+		partial.order.push_back(name);
+		partial.hists[name] = Entry{std::move(hist), source};
+		return true;
+	}
+
+	if (!SameBinning(it->second.hist.get(), hist.get()))
+	{
+		Log("[merge_outputs] Binning of " + name + " in " + source + " differs from " + it->second.source);
+		return false;
+	}
+	it->second.hist->Add(hist.get());
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Reads every histogram of a file into a partial sum and lists its trees.
+ * @return False if the file cannot be read or a histogram has a different binning.
+ */
+bool AddFile(Partial &partial, const std::string &input, std::set<std::string> &trees)
+{
+	std::unique_ptr<TFile> file(TFile::Open(input.c_str(), "READ"));
+	if (!file || file->IsZombie())
+	{
+		Log("[merge_outputs] Cannot open " + input);
+		return false;
+	}
+
+	bool ok = true;
+	for (auto *object : *file->GetListOfKeys())
+	{
+		auto key = static_cast<TKey *>(object);
+		TClass *type = TClass::GetClass(key->GetClassName());
+		if (!type)
+			continue;
+
+		if (type->InheritsFrom(TTree::Class()))
+		{
+			trees.insert(key->GetName());
+		}
+		else if (type->InheritsFrom(TH1::Class()))
+		{
+			std::unique_ptr<TH1> hist(static_cast<TH1 *>(key->ReadObj()));
+			ok = Add(partial, key->GetName(), std::move(hist), input) && ok;
+		}
+	}
+	return ok;
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Merges partial b into partial a (one step of the reduction tree).
+ */
+bool MergeInto(Partial &a, Partial &b)
+{
+	bool ok = true;
+	for (const auto &name : b.order)
+	{
+		Entry &entry = b.hists[name];
+		ok = Add(a, name, std::move(entry.hist), entry.source) && ok;
+	}
+	b = Partial();
+	return ok;
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+/**
+ * @brief Draws the summary histograms as <dir>/<name>.pdf.
+ */
+void WritePlots(const Partial &merged, const std::string &dir)
+{
+	for (const auto &name : kPlotNames)
+	{
+		auto it = merged.hists.find(name);
+		if (it == merged.hists.end())
+			continue;
+
+		TH1 *hist = it->second.hist.get();
+		TCanvas canvas("c", "Canvas", 800, 600);
+		auto range = kPlotRanges.find(name);
+		if (range != kPlotRanges.end())
+			hist->GetXaxis()->SetRangeUser(range->second.first, range->second.second);
+
+		hist->Draw();
+		canvas.SaveAs((dir + "/" + name + ".pdf").c_str());
+		hist->GetXaxis()->SetRange(); // full range in the merged file
+	}
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Writes the run record of the merged file.
+ */
+void WriteRecord(const std::string &output, std::size_t nInputs, const std::string &configurationHash,
+				 long long requested, long long completed, const Partial &merged)
+{
+	std::string base = output;
+	if (base.size() > 5 && base.compare(base.size() - 5, 5, ".root") == 0)
+		base.resize(base.size() - 5);
+
+	std::ofstream out(base + ".json");
+	out << "{\n"
+		<< "  \"output\": \"" << output << "\",\n"
+		<< "  \"inputs\": " << nInputs << ",\n"
+		<< "  \"configurationHash\": \"" << configurationHash << "\",\n"
+		<< "  \"events\": {\n"
+		<< "    \"requested\": " << requested << ",\n"
+		<< "    \"completed\": " << completed << "\n"
+		<< "  },\n"
+		<< "  \"histograms\": [";
+	for (std::size_t i = 0; i < merged.order.size(); ++i)
+	{
+		const TAxis *axis = merged.hists.at(merged.order[i]).hist->GetXaxis();
+		out << (i ? ",\n" : "\n") << "    {\"name\": \"" << merged.order[i] << "\", \"nBins\": " << axis->GetNbins()
+			<< ", \"xMin\": " << axis->GetXmin() << ", \"xMax\": " << axis->GetXmax() << "}";
+	}
+	out << "\n  ]\n}\n";
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * @brief Prints the command-line help.
+ */
+void PrintUsage()
+{
+	std::cout << "Usage: merge_outputs <file.root>... [options]\n"
+			  << "  -o <file.root>   Merged output (default: merged_output.root)\n"
+			  << "  -j <N>           Threads (default: all cores)\n"
+			  << "  --pdf <dir>      Write the summary PDFs of the merged histograms to <dir>\n"
+			  << "  --force          Merge despite binning or configuration mismatches\n"
+			  << "                   (mismatching histograms are skipped)\n"
+			  << "  @<list>          Read input file names from <list>, one per line\n";
+}
+} // namespace
+
+// ============================================================================
+// Main
+// ============================================================================
+
+/**
+ * @brief Merges the inputs with a parallel tree reduction.
+ *
+ * Each thread reads a share of the files into its own partial sum; the
+ * partial sums are then combined pairwise in parallel (log2 of the thread
+ * count levels). Trees (ntuples) are concatenated with TChain::Merge. Inputs
+ * with a JSON run record are checked for a common configuration, and the
+ * merged file gets a record with the summed event counts.
+ */
+int main(int argc, char **argv)
+{
+	Options opt;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		auto next = [&]() -> std::string { return i + 1 < argc ? argv[++i] : ""; };
+
+		if (arg == "-o")
+			opt.output = next();
+		else if (arg == "-j")
+			opt.jobs = static_cast<unsigned>(std::atoi(next().c_str()));
+		else if (arg == "--pdf")
+			opt.pdfDir = next();
+		else if (arg == "--force")
+			opt.force = true;
+		else if (!arg.empty() && arg[0] == '@')
+		{
+			std::ifstream list(arg.substr(1));
+			for (std::string line; std::getline(list, line);)
+			{
+				if (!line.empty())
+					opt.inputs.push_back(line);
+			}
+		}
+		else if (!arg.empty() && arg[0] != '-')
+			opt.inputs.push_back(arg);
+		else
+		{
+			PrintUsage();
+			return arg == "--help" ? 0 : 2;
+		}
+	}
+
+	if (opt.inputs.empty())
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	ROOT::EnableThreadSafety();
+	TH1::AddDirectory(false);
+	gROOT->SetBatch(true);
+
+	unsigned nThreads = opt.jobs > 0 ? opt.jobs : std::max(1u, std::thread::hardware_concurrency());
+	nThreads = std::min<unsigned>(nThreads, static_cast<unsigned>(opt.inputs.size()));
+
+	// ----- Level 0: every thread sums a share of the files -----
+	std::vector<Partial> partials(nThreads);
+	std::vector<Record> records(opt.inputs.size());
+	std::vector<std::set<std::string>> trees(nThreads);
+	std::atomic<std::size_t> nextInput{0};
+	std::atomic<bool> ok{true};
+	{
+		std::vector<std::thread> workers;
+		for (unsigned t = 0; t < nThreads; ++t)
+		{
+			workers.emplace_back([&, t]() {
+				for (std::size_t i = nextInput++; i < opt.inputs.size(); i = nextInput++)
+				{
+					records[i] = ReadRecord(opt.inputs[i]);
+					if (!AddFile(partials[t], opt.inputs[i], trees[t]))
+						ok = false;
+				}
+			});
+		}
+		for (auto &worker : workers)
+			worker.join();
+	}
+
+	// ----- Reduction: combine partial sums pairwise -----
+	for (std::size_t stride = 1; stride < partials.size(); stride *= 2)
+	{
+		std::vector<std::thread> workers;
+		for (std::size_t i = 0; i + stride < partials.size(); i += 2 * stride)
+		{
+			workers.emplace_back([&, i, stride]() {
+				if (!MergeInto(partials[i], partials[i + stride]))
+					ok = false;
+			});
+		}
+		for (auto &worker : workers)
+			worker.join();
+	}
+	const Partial &merged = partials.front();
+
+	// ----- Configuration check -----
+	std::map<std::string, std::vector<std::string>> configurations;
+	long long requested = 0;
+	long long completed = 0;
+	std::size_t nRecords = 0;
+	for (std::size_t i = 0; i < records.size(); ++i)
+	{
+		if (!records[i].found)
+			continue;
+		++nRecords;
+		requested += records[i].requested;
+		completed += records[i].completed;
+		configurations[Hash(records[i].configuration)].push_back(opt.inputs[i]);
+	}
+
+	if (configurations.size() > 1)
+	{
+		std::cerr << "[merge_outputs] Inputs come from " << configurations.size() << " different configurations:\n";
+		for (const auto &[hash, files] : configurations)
+			std::cerr << "  " << hash << ": " << files.size() << " file(s), e.g. " << files.front() << "\n";
+		ok = false;
+	}
+	if (nRecords < records.size())
+	{
+		std::cerr << "[merge_outputs] " << records.size() - nRecords
+				  << " input(s) without a run record (.json): configuration not checked\n";
+	}
+
+	if (!ok && !opt.force)
+	{
+		std::cerr << "[merge_outputs] Inconsistent inputs, nothing written (use --force to merge anyway)\n";
+		return 1;
+	}
+
+	// ----- Output: histograms, then trees -----
+	std::unique_ptr<TFile> out(TFile::Open(opt.output.c_str(), "RECREATE"));
+	if (!out || out->IsZombie())
+	{
+		std::cerr << "[merge_outputs] Cannot write " << opt.output << "\n";
+		return 1;
+	}
+	out->cd();
+	for (const auto &name : merged.order)
+		merged.hists.at(name).hist->Write(name.c_str());
+
+	std::set<std::string> treeNames;
+	for (const auto &names : trees)
+		treeNames.insert(names.begin(), names.end());
+	for (const auto &name : treeNames)
+	{
+		TChain chain(name.c_str());
+		for (const auto &input : opt.inputs)
+			chain.Add(input.c_str());
+		chain.Merge(out.get(), 0, "keep");
+	}
+	out->Close();
+
+	std::string configurationHash = configurations.size() == 1 ? configurations.begin()->first : "mixed";
+	if (nRecords > 0)
+		WriteRecord(opt.output, opt.inputs.size(), configurationHash, requested, completed, merged);
+
+	if (!opt.pdfDir.empty())
+		WritePlots(merged, opt.pdfDir);
+
+	std::cout << "[merge_outputs] Merged " << opt.inputs.size() << " file(s) with " << nThreads << " thread(s): "
+			  << merged.order.size() << " histogram(s), " << treeNames.size() << " tree(s)";
+	if (nRecords > 0)
+		std::cout << ", " << completed << " events";
+	std::cout << " -> " << opt.output << "\n";
+	return 0;
+}